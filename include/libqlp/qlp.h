@@ -11,6 +11,14 @@
 #ifndef _QLP_H_INCLUDED_
 #define _QLP_H_INCLUDED_
 
+#include <stdio.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#define QLP_MAX_JOBS 256 /* QLP_setJobs() */
+
 /********************/
 /* Type definitions */
 /********************/
@@ -24,29 +32,36 @@ typedef enum ERROR
     ERR_INVALID_ARGUMENT,
     ERR_OUT_OF_MEMORY,
     ERR_MATCH_NOT_FOUND,
+    ERR_FORMAT_NOT_SUPPORTED,
+    ERR_WRITE_FAILED,
     /* ERR_xxx */
     ERR_DEFAULT = -1, /* EXIT_FAILURE */
     ERR_NONE = 0 /* EXIT_SUCCESS */
 } EN_ERROR;
 
-typedef struct KILL
+typedef struct ARENA
 {
-    char *buffer;
-    struct KILL *next;
-} ST_KILL;
+    struct ARENA_BLOCK *block; /* Current block, chained to older ones */
+    unsigned long size; /* Of the largest block */
+} ST_ARENA;
 
 typedef struct MATCH
 {
-    ST_KILL *kill;
-    char *buffer;
-    struct MATCH *next;
+    struct MATCH_REPORT *report; /* Aggregates, from ST_LOG.arena */
+    unsigned long offset; /* Relative to ST_LOG.buffer */
+    unsigned long size;
 } ST_MATCH;
 
 typedef struct LOG
 {
+    ST_ARENA arena; /* Match reports */
     ST_MATCH *match;
     char *buffer;
     char *file;
+    unsigned long size;
+    int mapped;
+    int matchCapacity;
+    int matchCount;
 } ST_LOG;
 
 typedef struct QLP
@@ -54,12 +69,16 @@ typedef struct QLP
     ST_LOG log;
 } ST_QLP;
 
+typedef struct QLP_CONTEXT ST_QLP_CONTEXT; /* Opaque (QLP_newContext()) */
+
 /********************/
 /* Public functions */
 /********************/
 
 /**
- * @brief Evaluates the content of a previously imported log file.
+ * @brief Evaluates the content of a previously imported log file: matches
+ * are found and aggregated (players, kills and kills by means), so no
+ * further parsing is needed by QLP_report().
  * 
  * @param[in,out] data parser file structure
  * 
@@ -69,7 +88,47 @@ extern int
 QLP_evaluate(ST_QLP *data);
 
 /**
- * @brief Imports a log file.
+ * @brief As QLP_evaluate(), within a context (see QLP_newContext()).
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in,out] data parser file structure
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_evaluate_r(ST_QLP_CONTEXT *context, ST_QLP *data);
+
+/**
+ * @brief Same as QLP_stream(), but keeps the file open and waits for appends
+ * (through inotify where available) instead of returning at EOF. Every match
+ * is reported as soon as it is closed. Returns once QLP_stop() is called
+ * (even before QLP_follow() itself) or the file is removed or renamed. A
+ * match without players or with a malformed line is skipped, so a live log
+ * keeps being followed.
+ *
+ * @param[in] file file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_follow(const char *file);
+
+/**
+ * @brief As QLP_follow(), within a context: it returns once
+ * QLP_stop_r(context) is called.
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] file file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_follow_r(ST_QLP_CONTEXT *context, const char *file);
+
+/**
+ * @brief Imports a log file. "-" stands for the standard input; pipes and
+ * other unseekable streams are read until EOF. gzip (and, if built with
+ * _ZSTD_, zstd) content is detected and decompressed on the fly.
  *
  * @param[in] file file name
  * @param[out] data parser file structure
@@ -80,7 +139,58 @@ extern int
 QLP_import(const char *file, ST_QLP *data);
 
 /**
- * @brief Creates a JSON report of a previously evaluated log file.
+ * @brief Creates a context: the settings (QLP_setJobs_r(),
+ * QLP_setCompact_r()), worker threads and report stream the QLP_xxx_r()
+ * calls run with. Contexts share no settings, threads nor buffers with each
+ * other nor with the QLP_xxx() calls (which run with a default context,
+ * behind a lock), so independent logs are parsed at once from distinct
+ * threads, one context each. The one thing they share is the process-wide
+ * player name table: names already in it are read without locks, but a name
+ * never seen before briefly locks it to be added (and it only grows). A
+ * context is used by one thread at a time.
+ * Needs QLP_start().
+ *
+ * @param[out] context autodescriptive (QLP_freeContext())
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_newContext(ST_QLP_CONTEXT **context);
+
+/**
+ * @brief Imports and evaluates a log file in a single call, as QLP_import()
+ * then QLP_evaluate() would, with the same outcome. The log is read, split
+ * into matches and aggregated at once by distinct threads (the ones of
+ * QLP_setJobs() aggregating), so reading and decompression overlap with
+ * the evaluation. Logs that cannot be mapped (compressed or not regular
+ * files) are read into an address range reserved beforehand: 64 GiB (512
+ * MiB on 32-bit builds), halved down to 64 MiB while the system refuses
+ * it. Once the range is exhausted, or if none is granted, the log is read
+ * on into the heap and evaluated as QLP_import() then QLP_evaluate() do.
+ *
+ * @param[in] file file name
+ * @param[out] data parser file structure
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_parse(const char *file, ST_QLP *data);
+
+/**
+ * @brief As QLP_parse(), within a context.
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] file file name
+ * @param[out] data parser file structure
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_parse_r(ST_QLP_CONTEXT *context, const char *file, ST_QLP *data);
+
+/**
+ * @brief Creates a JSON report of a previously evaluated log file (only
+ * serializes the aggregates of QLP_evaluate()) on the standard output.
  * 
  * @param[in] data parser file structure
  * 
@@ -89,6 +199,136 @@ QLP_import(const char *file, ST_QLP *data);
 extern int
 QLP_report(ST_QLP *data);
 
+/**
+ * @brief As QLP_report(), within a context.
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in] data parser file structure
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_report_r(ST_QLP_CONTEXT *context, ST_QLP *data);
+
+/**
+ * @brief As QLP_report(), to a file descriptor. The report is written in
+ * large chunks while it is serialized, so it never sits whole in memory.
+ * The descriptor is left open.
+ * 
+ * @param[in] data parser file structure
+ * @param[in] fd output file descriptor
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportFd(ST_QLP *data, int fd);
+
+/**
+ * @brief As QLP_reportFd(), within a context.
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in] data parser file structure
+ * @param[in] fd output file descriptor
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportFd_r(ST_QLP_CONTEXT *context, ST_QLP *data, int fd);
+
+/**
+ * @brief As QLP_reportFd(), to a stream (flushed, but left open).
+ * 
+ * @param[in] data parser file structure
+ * @param[in] file output stream
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportFile(ST_QLP *data, FILE *file);
+
+/**
+ * @brief As QLP_reportFile(), within a context.
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in] data parser file structure
+ * @param[in] file output stream
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportFile_r(ST_QLP_CONTEXT *context, ST_QLP *data, FILE *file);
+
+/**
+ * @brief As QLP_reportFd(), to a file, created or truncated.
+ * 
+ * @param[in] data parser file structure
+ * @param[in] file output file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportPath(ST_QLP *data, const char *file);
+
+/**
+ * @brief As QLP_reportPath(), within a context.
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in] data parser file structure
+ * @param[in] file output file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportPath_r(ST_QLP_CONTEXT *context, ST_QLP *data, const char *file);
+
+/**
+ * @brief Sets the layout of the reports printed from now on: unformatted,
+ * as cJSON_PrintUnformatted(), or indented, as cJSON_Print() (default).
+ * Both carry the same JSON value.
+ *
+ * @param[in] compact 1 for unformatted reports, 0 for indented reports
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_setCompact(int compact);
+
+/**
+ * @brief As QLP_setCompact(), for the reports of a context.
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] compact 1 for unformatted reports, 0 for indented reports
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_setCompact_r(ST_QLP_CONTEXT *context, int compact);
+
+/**
+ * @brief Sets the number of threads QLP_evaluate() spreads
+ * matches over, the calling thread included. Matches are independent, so
+ * each one is tokenized and aggregated by a single thread, and reports are
+ * still printed in match order. Defaults to 1 (no worker threads).
+ *
+ * @param[in] jobs number of threads (1 to QLP_MAX_JOBS)
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_setJobs(int jobs);
+
+/**
+ * @brief As QLP_setJobs(), for the threads of a context (created on demand,
+ * joined by QLP_freeContext()).
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] jobs number of threads
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_setJobs_r(ST_QLP_CONTEXT *context, int jobs);
+
 /**
  * @brief Initializes the QLP API.
  * 
@@ -97,6 +337,48 @@ QLP_report(ST_QLP *data);
 extern int
 QLP_start(void);
 
+/**
+ * @brief Requests a running QLP_follow() to report the match in progress
+ * and return. Async-signal-safe (e.g. to be called from a SIGINT handler).
+ */
+extern void
+QLP_stop(void);
+
+/**
+ * @brief As QLP_stop(), for a QLP_follow_r() running within a context.
+ * Async-signal-safe.
+ *
+ * @param[in,out] context autodescriptive
+ */
+extern void
+QLP_stop_r(ST_QLP_CONTEXT *context);
+
+/**
+ * @brief Imports, evaluates and reports a log file in bounded memory. The
+ * file is read through a fixed-size buffer and each match is reported as
+ * soon as it is closed, with the same output as QLP_import(),
+ * QLP_evaluate() and QLP_report(). Lines must fit in the buffer (64 KiB,
+ * newline included): a longer one fails with ERR_FORMAT_NOT_SUPPORTED
+ * instead of being reported differently.
+ *
+ * @param[in] file file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_stream(const char *file);
+
+/**
+ * @brief As QLP_stream(), within a context.
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] file file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_stream_r(ST_QLP_CONTEXT *context, const char *file);
+
 /**
  * @brief Safely deallocates memory from the given input.
  * 
@@ -105,4 +387,13 @@ QLP_start(void);
 extern void
 QLP_free(ST_QLP *data);
 
+/**
+ * @brief Releases a context, joining its worker threads. The default
+ * context is left untouched.
+ * 
+ * @param[in,out] context autodescriptive
+ */
+extern void
+QLP_freeContext(ST_QLP_CONTEXT *context);
+
 #endif /* #ifndef _QLP_H_INCLUDED_ */
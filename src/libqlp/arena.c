@@ -0,0 +1,191 @@
+/**
+ * @file arena.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief ARENA API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#define ARENA_ALIGN (sizeof(void *) * 2) /* As malloc() */
+#define ARENA_BLOCK_SIZE (4 * 1024) /* First block */
+#define ARENA_MAX_BLOCK_SIZE (1024 * 1024) /* Doubling stops here */
+
+#define ARENA_HEADER_SIZE \
+    ( \
+    (sizeof(ST_ARENA_BLOCK) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN \
+    )
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static ST_ARENA_BLOCK *
+grow(ST_ARENA *data, unsigned long size);
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref arena.h
+ *
+ * @param[in,out] data arena structure (zeroed for a new arena)
+ * @param[in] size autodescriptive
+ *
+ * @return void * allocated memory (not zeroed) or NULL
+ */
+extern void *
+ARENA_alloc(ST_ARENA *data, unsigned long size)
+{
+    ST_ARENA_BLOCK *block;
+    void *pointer;
+
+    if (!data || !size)
+    {
+        return NULL;
+    }
+
+    size = (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+
+    block = data->block;
+
+    if (!block || block->size - block->used < size)
+    {
+        block = grow(data, size);
+
+        if (!block)
+        {
+            return NULL;
+        }
+    }
+
+    pointer = (char *) block + ARENA_HEADER_SIZE + block->used;
+
+    block->used += size;
+
+    return pointer;
+}
+
+/**
+ * @brief @ref arena.h
+ *
+ * @param[in,out] data arena structure
+ */
+extern void
+ARENA_free(ST_ARENA *data)
+{
+    ST_ARENA_BLOCK *block;
+
+    if (!data)
+    {
+        return;
+    }
+
+    while (data->block)
+    {
+        block = data->block->next;
+
+        free(data->block);
+
+        data->block = block;
+    }
+
+    data->size = 0;
+}
+
+/**
+ * @brief @ref arena.h
+ *
+ * @param[in,out] data arena structure
+ */
+extern void
+ARENA_reset(ST_ARENA *data)
+{
+    ST_ARENA_BLOCK *block;
+    ST_ARENA_BLOCK *largest;
+
+    if (!data || !data->block)
+    {
+        return;
+    }
+
+    largest = data->block;
+
+    for (block = data->block->next; block; block = block->next)
+    {
+        largest = (block->size > largest->size) ? block : largest; /* Not the most recent after an oversized request */
+    }
+
+    while (data->block)
+    {
+        block = data->block->next;
+
+        if (data->block != largest)
+        {
+            free(data->block);
+        }
+
+        data->block = block;
+    }
+
+    largest->next = NULL;
+
+    largest->used = 0;
+
+    data->block = largest;
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Chains a new block to an arena, twice as large as the previous one
+ * (up to ARENA_MAX_BLOCK_SIZE), or as large as the request, if larger.
+ *
+ * @param data arena structure
+ * @param size aligned request
+ *
+ * @return ST_ARENA_BLOCK * new current block or NULL
+ */
+static ST_ARENA_BLOCK *
+grow(ST_ARENA *data, unsigned long size)
+{
+    ST_ARENA_BLOCK *block;
+    unsigned long capacity;
+
+    capacity = (data->size) ? data->size * 2 : ARENA_BLOCK_SIZE;
+
+    capacity = (capacity < ARENA_MAX_BLOCK_SIZE) ? capacity : ARENA_MAX_BLOCK_SIZE;
+
+    capacity = (capacity - ARENA_HEADER_SIZE < size) ? size + ARENA_HEADER_SIZE : capacity;
+
+    block = (ST_ARENA_BLOCK *) malloc(capacity);
+
+    if (!block)
+    {
+        return NULL;
+    }
+
+    block->next = data->block;
+
+    block->size = capacity - ARENA_HEADER_SIZE;
+
+    block->used = 0;
+
+    data->block = block;
+
+    data->size = (capacity > data->size) ? capacity : data->size;
+
+    return block;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file arena.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _ARENA_H_INCLUDED_
+#define _ARENA_H_INCLUDED_
+
+#include "qlp.h"
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef struct ARENA_BLOCK
+{
+    struct ARENA_BLOCK *next; /* Previous (older) block */
+    unsigned long size; /* Usable bytes */
+    unsigned long used;
+} ST_ARENA_BLOCK;
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Allocates from an arena by bumping a pointer. Blocks double in size
+ * as the arena grows, so malloc() is only hit once in a while. Memory is
+ * aligned for any type and is only released, all at once, by ARENA_free().
+ * Arenas are not thread-safe: give each thread its own.
+ *
+ * @param[in,out] data arena structure (zeroed for a new arena)
+ * @param[in] size autodescriptive
+ *
+ * @return void * allocated memory (not zeroed) or NULL
+ */
+extern void *
+ARENA_alloc(ST_ARENA *data, unsigned long size);
+
+/**
+ * @brief Releases every block of an arena, leaving it empty and reusable.
+ *
+ * @param[in,out] data arena structure
+ */
+extern void
+ARENA_free(ST_ARENA *data);
+
+/**
+ * @brief Empties an arena for reuse: its largest block is kept (the most
+ * recent one, on ties), the others are released. An arena reset once per
+ * task stops hitting malloc() once that block holds a whole task.
+ *
+ * @param[in,out] data arena structure
+ */
+extern void
+ARENA_reset(ST_ARENA *data);
+
+#endif /* #ifndef _ARENA_H_INCLUDED_ */
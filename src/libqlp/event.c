@@ -0,0 +1,334 @@
+/**
+ * @file event.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief EVENT API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "event.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static const char *
+find(const char *stream, const char *limit, const char *key, unsigned long lenght);
+
+static int
+parseKill(const char *stream, const char *limit, ST_EVENT *data);
+
+static int
+parseNumber(const char **stream, const char *limit, int *value);
+
+static int
+parsePlayer(const char *stream, const char *limit, ST_EVENT *data);
+
+static int
+parseTime(const char *buffer, const char *stream);
+
+static void
+setField(ST_EVENT *data, int field, const char *stream, const char *begin, const char *end);
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref event.h
+ *
+ * @param[in] buffer autodescriptive (event offsets are relative to it)
+ * @param[in] size size of buffer
+ * @param[in,out] offset where to start, updated to the end of the event
+ * @param[out] data event structure
+ *
+ * @return int 1 if an event was found, 0 otherwise
+ */
+extern int
+EVENT_next(const char *buffer, unsigned long size, unsigned long *offset, ST_EVENT *data)
+{
+    const char *end;
+    const char *limit;
+    const char *pointer;
+    int key;
+
+    if (!buffer || !offset || !data || *offset >= size)
+    {
+        return 0;
+    }
+
+    limit = buffer + size;
+
+    pointer = SCAN_next(buffer + *offset, size - *offset, SCAN_KILL | SCAN_MATCH | SCAN_PLAYER | SCAN_SHUTDOWN, &key);
+
+    if (!pointer)
+    {
+        *offset = size;
+
+        return 0;
+    }
+
+    end = (const char *) memchr(pointer, '\n', (size_t) (limit - pointer));
+
+    end = (end) ? end : limit;
+
+    memset(data, 0, sizeof(ST_EVENT));
+
+    data->id[0] = data->id[1] = data->id[2] = -1;
+
+    data->offset = (unsigned long) (pointer - buffer);
+
+    data->size = (unsigned int) (end - pointer);
+
+    data->time = parseTime(buffer, pointer);
+
+    switch (key)
+    {
+    case SCAN_KILL:
+        data->type = (parseKill(pointer, end, data)) ? EVENT_UNKNOWN : EVENT_KILL;
+        break;
+
+    case SCAN_MATCH:
+        data->type = EVENT_MATCH;
+        break;
+
+    case SCAN_PLAYER:
+        data->type = (parsePlayer(pointer, end, data)) ? EVENT_UNKNOWN : EVENT_PLAYER;
+        break;
+
+    default:
+        data->type = EVENT_SHUTDOWN;
+        break;
+    }
+
+    *offset = (unsigned long) (end - buffer); /* Next line */
+
+    return 1;
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Finds a separator within a line. Fields are a few bytes long, so a
+ * plain loop beats a memchr() call per candidate.
+ *
+ * @param stream autodescriptive
+ * @param limit end of stream
+ * @param key separator
+ * @param lenght lenght of separator
+ *
+ * @return const char * first occurrence or NULL
+ */
+static const char *
+find(const char *stream, const char *limit, const char *key, unsigned long lenght)
+{
+    for (; (unsigned long) (limit - stream) >= lenght; stream++)
+    {
+        if (*stream == *key && !memcmp(stream, key, lenght))
+        {
+            return stream;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Tokenizes a kill line:
+ * "Kill: <killer ID> <victim ID> <MOD ID>: <killer> killed <victim> by <MOD>".
+ *
+ * @param stream kill line, starting at QLP_KEY_KILL
+ * @param limit end of line
+ * @param data event structure
+ *
+ * @return int ERR_xxx
+ */
+static int
+parseKill(const char *stream, const char *limit, ST_EVENT *data)
+{
+    const char *begin;
+    const char *end;
+    int i;
+
+    begin = stream + strlen(QLP_KEY_KILL);
+
+    for (i = FIELD_KILLER; i <= FIELD_MEAN_OF_DEATH; i++)
+    {
+        if (parseNumber(&begin, limit, &data->id[i]))
+        {
+            return ERR_INVALID_ARGUMENT;
+        }
+    }
+
+    if (limit - begin < 2 || memcmp(begin, ": ", 2))
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    begin += 2; /* ": " */
+
+    end = find(begin, limit, " killed ", strlen(" killed "));
+
+    if (!end)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    setField(data, FIELD_KILLER, stream, begin, end);
+
+    begin = end + strlen(" killed ");
+
+    end = find(begin, limit, " by ", strlen(" by "));
+
+    if (!end)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    setField(data, FIELD_VICTIM, stream, begin, end);
+
+    setField(data, FIELD_MEAN_OF_DEATH, stream, end + strlen(" by "), limit);
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Parses a non-negative decimal number, skipping leading blanks.
+ *
+ * @param stream autodescriptive, moved past the number
+ * @param limit end of stream
+ * @param value parsed number
+ *
+ * @return int ERR_xxx
+ */
+static int
+parseNumber(const char **stream, const char *limit, int *value)
+{
+    const char *pointer;
+
+    pointer = *stream;
+
+    while (pointer < limit && *pointer == ' ')
+    {
+        pointer++;
+    }
+
+    if (pointer >= limit || *pointer < '0' || *pointer > '9')
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    *value = 0;
+
+    while (pointer < limit && *pointer >= '0' && *pointer <= '9' && *value < 100000000)
+    {
+        *value = *value * 10 + (*pointer++ - '0');
+    }
+
+    *stream = pointer;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Tokenizes a player line:
+ * "ClientUserinfoChanged: <client> n\<name>\t\...".
+ *
+ * @param stream player line, starting at QLP_KEY_PLAYER
+ * @param limit end of line
+ * @param data event structure
+ *
+ * @return int ERR_xxx
+ */
+static int
+parsePlayer(const char *stream, const char *limit, ST_EVENT *data)
+{
+    const char *begin;
+    const char *end;
+
+    begin = stream + strlen(QLP_KEY_PLAYER);
+
+    if (parseNumber(&begin, limit, &data->id[FIELD_PLAYER]))
+    {
+        data->id[FIELD_PLAYER] = -1; /* Not mandatory */
+    }
+
+    begin = find(begin, limit, "n\\", strlen("n\\"));
+
+    if (!begin)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    begin += 2; /* "n\" */
+
+    end = find(begin, limit, "\\t", strlen("\\t"));
+
+    if (!end)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    setField(data, FIELD_PLAYER, stream, begin, end);
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Parses the "<minutes>:<seconds>" timestamp opening the line of a
+ * key.
+ *
+ * @param buffer start of the tokenized buffer
+ * @param stream key
+ *
+ * @return int seconds, -1 if missing
+ */
+static int
+parseTime(const char *buffer, const char *stream)
+{
+    const char *begin;
+    int minutes;
+    int seconds;
+
+    begin = stream;
+
+    while (begin > buffer && begin[-1] != '\n')
+    {
+        begin--; /* Line start */
+    }
+
+    if (parseNumber(&begin, stream, &minutes) || begin >= stream || *begin++ != ':')
+    {
+        return -1;
+    }
+
+    if (parseNumber(&begin, stream, &seconds))
+    {
+        return -1;
+    }
+
+    return minutes * 60 + seconds;
+}
+
+/**
+ * @brief Sets a field of an event, relative to its key.
+ *
+ * @param data event structure
+ * @param field FIELD_xxx
+ * @param stream key
+ * @param begin start of field
+ * @param end end of field
+ */
+static void
+setField(ST_EVENT *data, int field, const char *stream, const char *begin, const char *end)
+{
+    data->field[field].offset = (unsigned int) (begin - stream);
+
+    data->field[field].size = (unsigned int) (end - begin);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file event.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _EVENT_H_INCLUDED_
+#define _EVENT_H_INCLUDED_
+
+#include "qlp.h"
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef enum EVENT_FIELD
+{
+    FIELD_KILLER = 0,
+    FIELD_VICTIM,
+    FIELD_MEAN_OF_DEATH,
+    FIELD_PLAYER = 0 /* Client slot and name */
+} EN_EVENT_FIELD;
+
+typedef enum EVENT_TYPE
+{
+    EVENT_UNKNOWN = 0, /* Key found, fields not understood */
+    EVENT_KILL,
+    EVENT_MATCH,
+    EVENT_PLAYER,
+    EVENT_SHUTDOWN
+} EN_EVENT_TYPE;
+
+typedef struct FIELD
+{
+    unsigned int offset; /* Relative to ST_EVENT.offset */
+    unsigned int size;
+} ST_FIELD;
+
+typedef struct EVENT
+{
+    ST_FIELD field[3]; /* FIELD_xxx */
+    unsigned long offset; /* Key, relative to the tokenized buffer */
+    unsigned int size; /* Up to the end of line */
+    int id[3]; /* FIELD_xxx (-1 if missing) */
+    int time; /* Seconds (-1 if missing) */
+    int type; /* EVENT_xxx */
+} ST_EVENT;
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Tokenizes the next event of a buffer: the first line, from offset
+ * on, holding a key. Only that line is read beyond the key, so a whole log
+ * is tokenized in a single pass by calling it until it fails.
+ *
+ * @param[in] buffer autodescriptive (event offsets are relative to it)
+ * @param[in] size size of buffer
+ * @param[in,out] offset where to start, updated to the end of the event
+ * @param[out] data event structure
+ *
+ * @return int 1 if an event was found, 0 otherwise
+ */
+extern int
+EVENT_next(const char *buffer, unsigned long size, unsigned long *offset, ST_EVENT *data);
+
+#endif /* #ifndef _EVENT_H_INCLUDED_ */
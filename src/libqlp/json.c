@@ -0,0 +1,411 @@
+/**
+ * @file json.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief JSON API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "json.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static void
+append(ST_JSON *data, const char *stream, unsigned long size);
+
+static void
+escape(ST_JSON *data, const char *value);
+
+static void
+indent(ST_JSON *data, int depth);
+
+static int
+output(ST_JSON *data);
+
+static void
+separate(ST_JSON *data);
+
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref json.h
+ *
+ * @param[in,out] data JSON stream structure
+ */
+extern void
+JSON_close(ST_JSON *data)
+{
+    if (data->depth <= 0)
+    {
+        return;
+    }
+
+    data->depth -= 1;
+
+    if (data->bracket[data->depth] == '}' && !data->compact)
+    {
+        append(data, "\n", 1);
+
+        indent(data, data->depth);
+    }
+
+    append(data, &data->bracket[data->depth], 1);
+}
+
+/**
+ * @brief @ref json.h
+ *
+ * @param[in,out] data JSON stream structure
+ *
+ * @return int ERR_xxx (ERR_WRITE_FAILED if any write failed since
+ * JSON_init())
+ */
+extern int
+JSON_flush(ST_JSON *data)
+{
+    if (data->count && !data->error)
+    {
+        data->error = output(data);
+    }
+
+    data->count = 0;
+
+    return (data->error) ? ERR_WRITE_FAILED : ERR_NONE;
+}
+
+/**
+ * @brief @ref json.h
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] compact 1 for unformatted output, 0 for indented output
+ * @param[in] file output stream (may be NULL)
+ * @param[in] fd output file descriptor (may be < 0)
+ */
+extern void
+JSON_init(ST_JSON *data, int compact, FILE *file, int fd)
+{
+    data->compact = compact;
+
+    data->depth = 0;
+
+    data->error = 0;
+
+    data->fd = fd;
+
+    data->file = file;
+}
+
+/**
+ * @brief @ref json.h
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] key autodescriptive
+ */
+extern void
+JSON_key(ST_JSON *data, const char *key)
+{
+    if (data->depth <= 0)
+    {
+        return;
+    }
+
+    if (!data->first[data->depth - 1])
+    {
+        append(data, ",", 1);
+    }
+
+    data->first[data->depth - 1] = 0;
+
+    if (!data->compact)
+    {
+        append(data, "\n", 1);
+
+        indent(data, data->depth);
+    }
+
+    escape(data, key);
+
+    append(data, (data->compact) ? ":" : ":\t", (data->compact) ? 1 : 2);
+}
+
+/**
+ * @brief @ref json.h
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] value autodescriptive
+ */
+extern void
+JSON_number(ST_JSON *data, int value)
+{
+    char digit[16];
+    int i;
+    unsigned int magnitude;
+
+    separate(data);
+
+    i = (int) sizeof(digit);
+
+    magnitude = (value < 0) ? 0u - (unsigned int) value : (unsigned int) value;
+
+    do
+    {
+        digit[--i] = (char) ('0' + magnitude % 10);
+
+        magnitude /= 10;
+    }
+    while (magnitude);
+
+    if (value < 0)
+    {
+        digit[--i] = '-';
+    }
+
+    append(data, digit + i, sizeof(digit) - i);
+}
+
+/**
+ * @brief @ref json.h
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] bracket '{' or '['
+ */
+extern void
+JSON_open(ST_JSON *data, char bracket)
+{
+    if (data->depth >= JSON_MAX_DEPTH)
+    {
+        return;
+    }
+
+    separate(data);
+
+    append(data, &bracket, 1);
+
+    data->bracket[data->depth] = (bracket == '{') ? '}' : ']';
+
+    data->first[data->depth] = 1;
+
+    data->depth += 1;
+}
+
+/**
+ * @brief @ref json.h
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] value NUL-terminated string
+ */
+extern void
+JSON_string(ST_JSON *data, const char *value)
+{
+    separate(data);
+
+    escape(data, value);
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Writes raw bytes. The buffer is flushed whenever it gets full, so
+ * a stream of any size is written through it.
+ *
+ * @param data JSON stream structure
+ * @param stream autodescriptive
+ * @param size size of stream
+ */
+static void
+append(ST_JSON *data, const char *stream, unsigned long size)
+{
+    unsigned long count;
+
+    while (size)
+    {
+        if (data->count == JSON_BUFFER_SIZE)
+        {
+            JSON_flush(data); /* Errors are sticky, see JSON_flush() */
+        }
+
+        count = JSON_BUFFER_SIZE - data->count;
+
+        count = (count < size) ? count : size;
+
+        memcpy(data->buffer + data->count, stream, count);
+
+        data->count += count;
+
+        stream += count;
+
+        size -= count;
+    }
+}
+
+/**
+ * @brief Writes a quoted string, escaped as cJSON does: quotes, backslashes
+ * and control characters only.
+ *
+ * @param data JSON stream structure
+ * @param value NUL-terminated string
+ */
+static void
+escape(ST_JSON *data, const char *value)
+{
+    const unsigned char *begin;
+    const unsigned char *end;
+    char sequence[8];
+
+    append(data, "\"", 1);
+
+    begin = end = (const unsigned char *) value;
+
+    for (; *end; end++)
+    {
+        if (*end > 31 && *end != '\"' && *end != '\\')
+        {
+            continue;
+        }
+
+        append(data, (const char *) begin, (unsigned long) (end - begin)); /* Plain run */
+
+        switch (*end)
+        {
+        case '\b':
+            strcpy(sequence, "\\b");
+            break;
+
+        case '\f':
+            strcpy(sequence, "\\f");
+            break;
+
+        case '\n':
+            strcpy(sequence, "\\n");
+            break;
+
+        case '\r':
+            strcpy(sequence, "\\r");
+            break;
+
+        case '\t':
+            strcpy(sequence, "\\t");
+            break;
+
+        case '\"':
+        case '\\':
+            sequence[0] = '\\'; sequence[1] = (char) *end; sequence[2] = 0;
+            break;
+
+        default:
+            sprintf(sequence, "\\u%04x", *end); /* Other control characters */
+            break;
+        }
+
+        append(data, sequence, strlen(sequence));
+
+        begin = end + 1;
+    }
+
+    append(data, (const char *) begin, (unsigned long) (end - begin));
+
+    append(data, "\"", 1);
+}
+
+/**
+ * @brief Writes the indentation of a level (one tab each).
+ *
+ * @param data JSON stream structure
+ * @param depth level
+ */
+static void
+indent(ST_JSON *data, int depth)
+{
+    for (; depth > 0; depth--)
+    {
+        append(data, "\t", 1);
+    }
+}
+
+/**
+ * @brief Writes the whole buffer out to the output of a JSON stream.
+ * Partial and interrupted writes to a file descriptor are resumed.
+ *
+ * @param data JSON stream structure
+ *
+ * @return int 1 if the write failed, 0 otherwise
+ */
+static int
+output(ST_JSON *data)
+{
+    const char *pointer;
+    unsigned long size;
+    ssize_t count;
+
+    if (data->fd < 0)
+    {
+        if (!data->file)
+        {
+            LIBQLP_WRITE(data->buffer, data->count);
+
+            return 0;
+        }
+
+        return fwrite(data->buffer, 1, data->count, data->file) != data->count;
+    }
+
+    pointer = data->buffer;
+
+    size = data->count;
+
+    while (size)
+    {
+        count = write(data->fd, pointer, size);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return 1;
+        }
+
+        pointer += count;
+
+        size -= (unsigned long) count;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Separates array items (object members are separated by
+ * JSON_key()).
+ *
+ * @param data JSON stream structure
+ */
+static void
+separate(ST_JSON *data)
+{
+    if (data->depth <= 0 || data->bracket[data->depth - 1] != ']')
+    {
+        return;
+    }
+
+    if (!data->first[data->depth - 1])
+    {
+        append(data, (data->compact) ? "," : ", ", (data->compact) ? 1 : 2);
+    }
+
+    data->first[data->depth - 1] = 0;
+}
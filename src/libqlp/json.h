@@ -0,0 +1,111 @@
+/**
+ * @file json.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _JSON_H_INCLUDED_
+#define _JSON_H_INCLUDED_
+
+#include "qlp.h"
+
+/**********/
+/* Macros */
+/**********/
+
+#define JSON_BUFFER_SIZE (64 * 1024)
+#define JSON_MAX_DEPTH 8
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef struct JSON
+{
+    FILE *file; /* Output stream, if fd < 0 (standard output, if NULL) */
+    unsigned long count; /* Bytes pending in buffer */
+    int compact; /* As cJSON_PrintUnformatted() (else as cJSON_Print()) */
+    int depth;
+    int error; /* A write failed since JSON_init() */
+    int fd; /* Output file descriptor (none, if < 0) */
+    char bracket[JSON_MAX_DEPTH]; /* Closing bracket of each open level */
+    char first[JSON_MAX_DEPTH]; /* No member written yet at each level */
+    char buffer[JSON_BUFFER_SIZE];
+} ST_JSON;
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Closes the innermost open object or array.
+ *
+ * @param[in,out] data JSON stream structure
+ */
+extern void
+JSON_close(ST_JSON *data);
+
+/**
+ * @brief Writes the pending bytes of a JSON stream out to its output.
+ *
+ * @param[in,out] data JSON stream structure
+ *
+ * @return int ERR_xxx (ERR_WRITE_FAILED if any write failed since
+ * JSON_init())
+ */
+extern int
+JSON_flush(ST_JSON *data);
+
+/**
+ * @brief Starts a new document (pending bytes are kept, so flush them
+ * before switching outputs). The output is a file descriptor if fd >= 0,
+ * file otherwise, or the standard output if both are unset.
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] compact 1 for unformatted output, 0 for indented output
+ * @param[in] file output stream (may be NULL)
+ * @param[in] fd output file descriptor (may be < 0)
+ */
+extern void
+JSON_init(ST_JSON *data, int compact, FILE *file, int fd);
+
+/**
+ * @brief Writes the key of the next object member.
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] key autodescriptive
+ */
+extern void
+JSON_key(ST_JSON *data, const char *key);
+
+/**
+ * @brief Writes an integer value.
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] value autodescriptive
+ */
+extern void
+JSON_number(ST_JSON *data, int value);
+
+/**
+ * @brief Opens an object ('{') or an array ('[') value.
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] bracket '{' or '['
+ */
+extern void
+JSON_open(ST_JSON *data, char bracket);
+
+/**
+ * @brief Writes a string value, escaped as cJSON does.
+ *
+ * @param[in,out] data JSON stream structure
+ * @param[in] value NUL-terminated string
+ */
+extern void
+JSON_string(ST_JSON *data, const char *value);
+
+#endif /* #ifndef _JSON_H_INCLUDED_ */
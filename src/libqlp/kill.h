@@ -1,39 +0,0 @@
-/**
- * @file kill.h
- * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
- * @platform cygwin64
- * @brief Namespace, class or interface definitions.
- * @date 2020-09-10
- * 
- */
-
-#ifndef _KILL_H_INCLUDED_
-#define _KILL_H_INCLUDED_
-
-#include "qlp.h"
-
-/********************/
-/* Public functions */
-/********************/
-
-/**
- * @brief Imports a kill stream.
- *
- * @param[in] stream kill buffer
- * @param[in] size size of kill stream
- * @param[out] data kill stream structure
- * 
- * @return int ERR_xxx
- */
-extern int
-KILL_import(const char *stream, unsigned long size, ST_KILL **data);
-
-/**
- * @brief Initializes the MATCH API.
- *
- * @return int ERR_xxx
- */
-extern int
-KILL_start(void);
-
-#endif /* #ifndef _KILL_H_INCLUDED_ */
@@ -7,33 +7,149 @@
  * 
  */
 
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS, MAP_NORESERVE */
+
 #include "log.h"
 
-#include <errno.h>
-#include <semaphore.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif /* #ifndef MAP_NORESERVE */
+
+#define LOG_CHUNK_SIZE (1024 * 1024) /* Bytes handed by the reader at once */
+
+#ifdef _UNIT_TESTS_
+#define LOG_RESERVE_SIZE (2UL * LOG_CHUNK_SIZE) /* Exhausted by UT0038 */
+
+#define LOG_RESERVE_MINIMUM LOG_CHUNK_SIZE
+#else
+#define LOG_RESERVE_SIZE \
+    ( \
+    (sizeof(void *) > 4) ? 64UL * 1024 * 1024 * 1024 : 512UL * 1024 * 1024 \
+    ) /* Address space for logs read through a pipeline (not mapped) */
+
+#define LOG_RESERVE_MINIMUM (64UL * LOG_CHUNK_SIZE) /* Smallest range tried */
+#endif /* _UNIT_TESTS_ */
 
 /********************/
-/* Global variables */
+/* Type definitions */
 /********************/
 
-static sem_t semaphore;
+typedef struct
+{
+    unsigned long size;
+    int match;
+} ST_ORDER;
+
+typedef struct TASK
+{
+    ST_MATCH match;
+    struct TASK *next; /* Next match, in log order */
+    int retValue;
+} ST_TASK;
+
+typedef struct
+{
+    int (*close)(void *context, unsigned long offset, unsigned long size); /* Once per match, in log order */
+    void *context;
+    unsigned long offset; /* Next byte to be scanned */
+    unsigned long open; /* Offset of the open match */
+    int opened; /* A match is open */
+} ST_SPLIT;
+
+typedef struct
+{
+    ST_ARENA arena; /* Tasks (splitter only) */
+    ST_LOG *log;
+    ST_SOURCE *source; /* NULL if mapped */
+    ST_TASK *first;
+    ST_TASK *last;
+    unsigned long capacity; /* Reserved bytes (not mapped), NUL excluded */
+    int jobs; /* Aggregators */
+    int next; /* Aggregator tried first (splitter only) */
+    int full; /* Reserved range exhausted (reader) */
+    int readValue; /* Reader outcome */
+    int splitValue; /* Splitter outcome */
+    ST_QUEUE input; /* Reader to splitter: end of the bytes read so far */
+    ST_QUEUE task[POOL_MAX_JOBS]; /* Splitter to aggregator i: closed matches */
+} ST_PIPELINE;
+
+typedef struct
+{
+    ST_LOG *log;
+    ST_ORDER *order; /* Task i evaluates match order[i].match */
+    int *retValue; /* One per match */
+} ST_EVALUATION;
 
 /***********************/
 /* Function prototypes */
 /***********************/
 
+static void
+aggregate(void *context, int index);
+
+static void
+aggregator(void *context, int index);
+
+static int
+append(ST_LOG *data, ST_MATCH **match);
+
+static void
+clear(ST_LOG *data);
+
+static int
+compare(const void *first, const void *second);
+
 static int
-evaluate(ST_LOG *data);
+dispatch(void *context, unsigned long offset, unsigned long size);
 
 static int
-fsize(const char *file, long int *fileSize);
+evaluate(ST_LOG *data, ST_POOL *pool);
 
 static int
 import(const char *file, ST_LOG *data);
 
+static int
+load(ST_SOURCE *source, ST_LOG *data);
+
+static int
+map(int fd, ST_LOG *data);
+
+static int
+openSource(const char *file, ST_LOG *data, ST_SOURCE *source, int *regular);
+
+static int
+parse(const char *file, ST_LOG *data, ST_POOL *pool);
+
+static void *
+reader(void *argument);
+
+static int
+reserve(ST_LOG *data, unsigned long *capacity);
+
+static int
+split(ST_LOG *data, ST_SPLIT *state, unsigned long limit, int eof);
+
+static void *
+splitter(void *argument);
+
+static int
+store(void *context, unsigned long offset, unsigned long size);
+
+static int
+tokenize(const char *buffer, ST_MATCH *match);
+
 /********************/
 /* Public functions */
 /********************/
@@ -42,29 +158,26 @@ import(const char *file, ST_LOG *data);
  * @brief @ref log.h
  * 
  * @param[in,out] data log file structure
+ * @param[in,out] pool threads matches are spread over
  * 
  * @return int ERR_xxx
  */
 extern int
-LOG_evaluate(ST_LOG *data)
+LOG_evaluate(ST_LOG *data, ST_POOL *pool)
 {
     int retValue;
 
-    LIBQLP_TRACE("data [%lu]", data);
-
-    sem_wait(&semaphore);
+    LIBQLP_TRACE("data [%lu], pool [%lu]", data, pool);
 
     retValue = ERR_INVALID_ARGUMENT;
 
-    if (data)
+    if (data && pool)
     {
-        retValue = evaluate(data);
+        retValue = evaluate(data, pool);
     }
 
     LIBQLP_TRACE("retValue [%d]", retValue);
 
-    sem_post(&semaphore);
-
     return retValue;
 }
 
@@ -83,13 +196,37 @@ LOG_import(const char *file, ST_LOG *data)
 
     LIBQLP_TRACE("*file [%s], data [%lu]", (file) ? file : "(null)", data);
 
-    sem_wait(&semaphore);
-
     retValue = import(file, data);
 
     LIBQLP_TRACE("retValue [%d]", retValue);
 
-    sem_post(&semaphore);
+    return retValue;
+}
+
+/**
+ * @brief @ref log.h
+ *
+ * @param[in] file file name
+ * @param[out] data log file structure
+ * @param[in,out] pool threads matches are spread over
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+LOG_parse(const char *file, ST_LOG *data, ST_POOL *pool)
+{
+    int retValue;
+
+    LIBQLP_TRACE("*file [%s], data [%lu], pool [%lu]", (file) ? file : "(null)", data, pool);
+
+    retValue = ERR_INVALID_ARGUMENT;
+
+    if (data && pool)
+    {
+        retValue = parse(file, data, pool);
+    }
+
+    LIBQLP_TRACE("retValue [%d]", retValue);
 
     return retValue;
 }
@@ -114,8 +251,6 @@ LOG_start(void)
         return ERR_DEFAULT;
     }
 
-    sem_init(&semaphore, 0, 1);
-
     return ERR_NONE;
 }
 
@@ -124,222 +259,1082 @@ LOG_start(void)
 /*********************/
 
 /**
- * @brief @ref LOG_evaluate()
+ * @brief POOL task: evaluates a match of an imported log (tokenize()).
  * 
- * @param data log file structure
+ * @param context ST_EVALUATION
+ * @param index task index
+ */
+static void
+aggregate(void *context, int index)
+{
+    ST_EVALUATION *evaluation;
+
+    evaluation = (ST_EVALUATION *) context;
+
+    index = evaluation->order[index].match;
+
+    evaluation->retValue[index] = tokenize(evaluation->log->buffer, &evaluation->log->match[index]);
+}
+
+/**
+ * @brief POOL task: pipeline aggregator, evaluating (tokenize()) the matches
+ * of its queue until it gets a NULL one.
  * 
- * @return int ERR_xxx
+ * @param context ST_PIPELINE
+ * @param index aggregator (queue) index
  */
-static int
-evaluate(ST_LOG *data)
+static void
+aggregator(void *context, int index)
 {
-    ST_MATCH **match;
-    char *begin;
-    char *end;
-    int retValue;
-    unsigned long size;
+    ST_PIPELINE *pipeline;
+    ST_TASK *task;
 
-    if (!data)
-    {
-        return ERR_INVALID_ARGUMENT;
-    }
+    pipeline = (ST_PIPELINE *) context;
 
-    if (!data->file || !data->buffer)
+    while ((task = (ST_TASK *) QUEUE_pop(&pipeline->task[index])))
     {
-        return ERR_INVALID_ARGUMENT;
+        task->retValue = tokenize(pipeline->log->buffer, &task->match);
     }
+}
 
-    match = &data->match;
-
-    begin = data->buffer;
+/**
+ * @brief Reserves a new entry at the end of the log match list.
+ * 
+ * @param data log file structure
+ * @param match new entry
+ * 
+ * @return int ERR_xxx
+ */
+static int
+append(ST_LOG *data, ST_MATCH **match)
+{
+    ST_MATCH *list;
+    int capacity;
 
-    while (begin)
+    if (data->matchCount >= data->matchCapacity)
     {
-        begin = strstr(begin, QLP_KEY_MATCH);
+        capacity = (data->matchCapacity) ? data->matchCapacity * 2 : 16;
 
-        if (!begin)
+        list = (ST_MATCH *) realloc(data->match, sizeof(ST_MATCH) * capacity);
+
+        if (!list)
         {
-            break;
+            return ERR_OUT_OF_MEMORY;
         }
 
-        end = strstr(begin + strlen(QLP_KEY_MATCH), QLP_KEY_MATCH);
+        data->match = list;
 
-        if (!end)
-        {
-            end = begin;
-        }
+        data->matchCapacity = capacity;
+    }
 
-        size = strlen(begin) - strlen(end);
+    *match = &data->match[data->matchCount++];
 
-        if (!size)
-        {
-            size = strlen(begin);
-        }
+    memset(*match, 0, sizeof(ST_MATCH));
 
-        retValue = MATCH_import(begin, size, match);
+    return ERR_NONE;
+}
 
-        if (retValue)
-        {
-            return retValue;
-        }
+/**
+ * @brief Releases the matches of a log.
+ * 
+ * @param data log file structure
+ */
+static void
+clear(ST_LOG *data)
+{
+    int i;
 
-        retValue = MATCH_evaluate(match);
+    for (i = 0; i < data->matchCount; i++)
+    {
+        MATCH_free(&data->match[i]);
+    }
 
-        if (retValue)
-        {
-            return retValue;
-        }
+    free(data->match);
 
-        match = &(*match)->next;
+    ARENA_free(&data->arena);
 
-        if (begin != end)
-        {
-            begin = end;
-        }
-        else
-        {
-            begin = NULL; /* EOF */
-        }
+    data->match = NULL;
+
+    data->matchCapacity = data->matchCount = 0;
+}
+
+/**
+ * @brief qsort() comparator: larger matches first, then log order.
+ * 
+ * @param first ST_ORDER
+ * @param second ST_ORDER
+ * 
+ * @return int <0, 0 or >0
+ */
+static int
+compare(const void *first, const void *second)
+{
+    const ST_ORDER *a;
+    const ST_ORDER *b;
+
+    a = (const ST_ORDER *) first;
+
+    b = (const ST_ORDER *) second;
+
+    if (a->size != b->size)
+    {
+        return (a->size > b->size) ? -1 : 1;
     }
 
-    return (!data->match) ? ERR_MATCH_NOT_FOUND : ERR_NONE;
+    return a->match - b->match;
 }
 
 /**
- * @brief Returns a file size. Inherently not thread safe.
- *
- * @param file file name
- * @param fileSize file size
- *
+ * @brief Splitter callback: hands a closed match to the aggregator with the
+ * fewest matches pending (the next one, round robin, on ties).
+ * 
+ * @param context ST_PIPELINE
+ * @param offset offset of the match stream
+ * @param size size of match stream
+ * 
  * @return int ERR_xxx
  */
 static int
-fsize(const char *file, long int *fileSize)
+dispatch(void *context, unsigned long offset, unsigned long size)
 {
-    FILE *filePointer;
+    ST_PIPELINE *pipeline;
+    ST_TASK *task;
+    int best;
+    int i;
+    int index;
+    int retValue;
+
+    pipeline = (ST_PIPELINE *) context;
 
-    if (!file || !fileSize)
+    task = (ST_TASK *) ARENA_alloc(&pipeline->arena, sizeof(ST_TASK));
+
+    if (!task)
     {
-        return ERR_INVALID_ARGUMENT;
+        return ERR_OUT_OF_MEMORY;
     }
 
-    filePointer = fopen(file, "r");
+    memset(task, 0, sizeof(ST_TASK));
 
-    if (!filePointer)
-    {
-        switch (errno)
-        {
-        case ENOENT:
-            return ERR_FILE_NOT_FOUND;
+    retValue = MATCH_import(offset, size, &pipeline->log->arena, &task->match);
 
-        default:
-            return ERR_DEFAULT;
-        }
+    if (retValue)
+    {
+        return retValue;
     }
 
-    fseek(filePointer, 0, SEEK_END);
-
-    *fileSize = ftell(filePointer);
+    if (pipeline->last)
+    {
+        pipeline->last->next = task;
+    }
+    else
+    {
+        pipeline->first = task;
+    }
 
-    fseek(filePointer, 0, SEEK_SET);
+    pipeline->last = task;
 
-    fclose(filePointer);
+    best = pipeline->next;
 
-    if (*fileSize < 0)
+    for (i = 1; i < pipeline->jobs; i++)
     {
-        return ERR_DEFAULT;
+        index = (pipeline->next + i) % pipeline->jobs;
+
+        if (QUEUE_pending(&pipeline->task[index]) < QUEUE_pending(&pipeline->task[best]))
+        {
+            best = index;
+        }
     }
 
+    pipeline->next = (best + 1) % pipeline->jobs;
+
+    QUEUE_push(&pipeline->task[best], task);
+
     return ERR_NONE;
 }
 
 /**
- * @brief @ref LOG_import()
+ * @brief @ref LOG_evaluate(). Match boundaries are found first (split()),
+ * then every match is tokenized and aggregated on its own (aggregate()),
+ * across the threads of a pool. Match sizes are skewed, so with more
+ * than one thread they are handed to the pool from the largest down: the
+ * largest ones start at once, while small ones fill the gaps (stolen by
+ * idle threads). Nothing is kept on failure.
  * 
- * @param file file name
  * @param data log file structure
+ * @param pool threads matches are spread over
  * 
  * @return int ERR_xxx
  */
 static int
-import(const char *file, ST_LOG *data)
+evaluate(ST_LOG *data, ST_POOL *pool)
 {
-    FILE *filePointer;
+    ST_EVALUATION evaluation;
+    ST_SPLIT state;
+    int i;
     int retValue;
-    long int fileSize;
 
-    if (!file || !data)
+    if (!data)
     {
         return ERR_INVALID_ARGUMENT;
     }
 
-    if (!file[0])
+    if (!data->file || !data->buffer)
     {
         return ERR_INVALID_ARGUMENT;
     }
 
-    memset(data, 0, sizeof(ST_LOG));
+    clear(data);
 
-    data->file = (char *) malloc(sizeof(char) * (strlen(file) + 1));
+    memset(&state, 0, sizeof(ST_SPLIT));
 
-    if (!data->file)
+    state.close = store;
+
+    state.context = data;
+
+    retValue = split(data, &state, data->size, 1);
+
+    if (!retValue && !data->matchCount)
+    {
+        retValue = ERR_MATCH_NOT_FOUND;
+    }
+
+    if (retValue)
+    {
+        clear(data);
+
+        return retValue;
+    }
+
+    evaluation.log = data;
+
+    evaluation.order = (ST_ORDER *) malloc(sizeof(ST_ORDER) * data->matchCount);
+
+    evaluation.retValue = (int *) calloc(data->matchCount, sizeof(int));
+
+    if (!evaluation.order || !evaluation.retValue)
     {
+        free(evaluation.order);
+
+        free(evaluation.retValue);
+
+        clear(data);
+
         return ERR_OUT_OF_MEMORY;
     }
 
-    strcpy(data->file, file);
+    for (i = 0; i < data->matchCount; i++)
+    {
+        evaluation.order[i].size = data->match[i].size;
 
-    retValue = fsize(data->file, &fileSize);
+        evaluation.order[i].match = i;
+    }
 
-    if (retValue)
+    if (pool->jobs > 1)
     {
-        free(data->file);
+        qsort(evaluation.order, data->matchCount, sizeof(ST_ORDER), compare);
+    }
 
-        return retValue;
+    POOL_run(pool, aggregate, &evaluation, data->matchCount);
+
+    for (i = 0; i < data->matchCount && !retValue; i++)
+    {
+        retValue = evaluation.retValue[i]; /* First failure, in log order */
     }
 
-    if (!fileSize)
+    free(evaluation.order);
+
+    free(evaluation.retValue);
+
+    if (retValue)
     {
-        free(data->file);
+        clear(data);
+    }
+
+    return retValue;
+}
+
+/**
+ * @brief @ref LOG_import()
+ * 
+ * @param file file name
+ * @param data log file structure
+ * 
+ * @return int ERR_xxx
+ */
+static int
+import(const char *file, ST_LOG *data)
+{
+    ST_SOURCE source;
+    int regular;
+    int retValue;
 
-        return ERR_FILE_EMPTY;
+    retValue = openSource(file, data, &source, &regular);
+
+    if (retValue)
+    {
+        return retValue;
     }
 
-    data->buffer = (char *) malloc(sizeof(char) * (fileSize + 1));
+    retValue = ERR_DEFAULT;
 
-    if (!data->buffer)
+    if (regular && source.format == FORMAT_PLAIN)
     {
-        free(data->file); free(data->buffer);
+        retValue = map(source.fd, data);
+    }
 
-        return ERR_OUT_OF_MEMORY;
+    if (retValue)
+    {
+        retValue = load(&source, data); /* Not mappable (e.g. pipes, special or compressed files) */
     }
 
-    filePointer = fopen(data->file, "r");
+    SOURCE_close(&source);
 
-    if (!filePointer)
+    return retValue;
+}
+
+/**
+ * @brief Reads a source until EOF into a NUL-terminated heap buffer. The size
+ * needs not to be known in advance (unseekable or compressed streams): the
+ * buffer starts from data->size, if any, and doubles whenever it gets full.
+ * A log partially read into a mapped buffer (data->buffer) is continued: its
+ * data->size bytes are moved to the heap first.
+ * 
+ * @param source source structure
+ * @param data log file structure
+ * 
+ * @return int ERR_xxx
+ */
+static int
+load(ST_SOURCE *source, ST_LOG *data)
+{
+    char *buffer;
+    int retValue;
+    unsigned long capacity;
+    unsigned long count;
+
+    if (data->buffer) /* Continued */
     {
-        free(data->file); free(data->buffer);
+        capacity = data->size * 2;
 
-        switch (errno)
-        {
-        case ENOENT:
-            return ERR_FILE_NOT_FOUND;
+        buffer = (char *) malloc(sizeof(char) * (capacity + 1));
 
-        default:
-            return ERR_INVALID_ARGUMENT;
+        if (!buffer)
+        {
+            return ERR_OUT_OF_MEMORY;
         }
-    }
 
-    fseek(filePointer, 0, SEEK_SET);
+        memcpy(buffer, data->buffer, data->size);
 
-    retValue = fread(data->buffer, sizeof(char), fileSize, filePointer);
+        munmap(data->buffer, data->size + 1);
 
-    fclose(filePointer);
+        data->buffer = buffer;
 
-    if (retValue != fileSize)
+        data->mapped = 0;
+    }
+    else
     {
-        return ERR_DEFAULT; /* Partial reading (mem. is kept allocated for further analysis) */
+        capacity = (data->size) ? data->size + 1 : QLP_STREAM_BUFFER_SIZE; /* +1: EOF is hit without growing */
+
+        data->size = 0;
+
+        data->buffer = (char *) malloc(sizeof(char) * (capacity + 1));
+
+        if (!data->buffer)
+        {
+            return ERR_OUT_OF_MEMORY;
+        }
     }
 
-    return ERR_NONE;
+    while (1)
+    {
+        if (data->size == capacity)
+        {
+            capacity *= 2;
+
+            buffer = (char *) realloc(data->buffer, sizeof(char) * (capacity + 1));
+
+            if (!buffer)
+            {
+                data->buffer[data->size] = 0;
+
+                return ERR_OUT_OF_MEMORY; /* Partial reading (mem. is kept allocated for further analysis) */
+            }
+
+            data->buffer = buffer;
+        }
+
+        retValue = SOURCE_read(source, data->buffer + data->size, capacity - data->size, &count);
+
+        if (retValue || !count)
+        {
+            break;
+        }
+
+        data->size += count;
+    }
+
+    data->buffer[data->size] = 0;
+
+    if (retValue)
+    {
+        return retValue; /* Partial reading (mem. is kept allocated for further analysis) */
+    }
+
+    return (data->size) ? ERR_NONE : ERR_FILE_EMPTY;
+}
+
+/**
+ * @brief Maps a whole file as a read-only, NUL-terminated buffer. A zeroed
+ * anonymous region one byte larger than the file is reserved first and the
+ * file is then mapped over it, so the byte right after the content always
+ * reads as '\0' (either the page tail or the reserved page).
+ * 
+ * @param fd file descriptor
+ * @param data log file structure
+ * 
+ * @return int ERR_xxx
+ */
+static int
+map(int fd, ST_LOG *data)
+{
+    void *address;
+
+    address = mmap(NULL, data->size + 1, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (address == MAP_FAILED)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    if (mmap(address, data->size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        munmap(address, data->size + 1);
+
+        return ERR_DEFAULT;
+    }
+
+    posix_madvise(address, data->size, POSIX_MADV_SEQUENTIAL);
+
+    data->buffer = (char *) address;
+
+    data->mapped = 1;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Opens the source of a log file, resetting the log structure.
+ * Regular files are checked for emptiness and their size is kept as a
+ * hint (data->size).
+ * 
+ * @param file file name
+ * @param data log file structure
+ * @param source source structure (SOURCE_close())
+ * @param regular 1 if the source is a regular file
+ * 
+ * @return int ERR_xxx
+ */
+static int
+openSource(const char *file, ST_LOG *data, ST_SOURCE *source, int *regular)
+{
+    struct stat status;
+    int retValue;
+
+    if (!file || !data)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (!file[0])
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    memset(data, 0, sizeof(ST_LOG));
+
+    data->file = (char *) malloc(sizeof(char) * (strlen(file) + 1));
+
+    if (!data->file)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    strcpy(data->file, file);
+
+    retValue = SOURCE_open(data->file, source);
+
+    if (retValue)
+    {
+        free(data->file); data->file = NULL;
+
+        return retValue;
+    }
+
+    if (fstat(source->fd, &status))
+    {
+        SOURCE_close(source); free(data->file); data->file = NULL;
+
+        return ERR_DEFAULT;
+    }
+
+    *regular = S_ISREG(status.st_mode) ? 1 : 0;
+
+    if (*regular)
+    {
+        if (!status.st_size)
+        {
+            SOURCE_close(source); free(data->file); data->file = NULL;
+
+            return ERR_FILE_EMPTY;
+        }
+
+        data->size = (unsigned long) status.st_size; /* Size hint for load() */
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref LOG_parse(). Three stages run at once, connected by queues:
+ * a reader thread (reader()) brings the log in, a splitter thread
+ * (splitter()) finds the match boundaries in what has been read, and the
+ * threads of the pool (aggregator()) evaluate every match as soon as it is
+ * closed. Plain files are mapped and only faulted in by the reader; other
+ * sources are read into a reserved address range, so the buffer never
+ * moves while matches are evaluated. If no range can be reserved, the log
+ * is imported and evaluated one step after the other; so is it, from where
+ * the reader stopped, once the range is exhausted (matches already
+ * evaluated are dropped). Nothing but the buffer is kept on failure.
+ * 
+ * @param file file name
+ * @param data log file structure
+ * @param pool threads matches are spread over
+ * 
+ * @return int ERR_xxx
+ */
+static int
+parse(const char *file, ST_LOG *data, ST_POOL *pool)
+{
+    ST_MATCH *match;
+    ST_PIPELINE *pipeline;
+    ST_SOURCE source;
+    ST_TASK *task;
+    pthread_t thread[2]; /* Reader, splitter */
+    long int page;
+    int i;
+    int reading;
+    int regular;
+    int retValue;
+    unsigned long keep;
+
+    retValue = openSource(file, data, &source, &regular);
+
+    if (retValue)
+    {
+        return retValue;
+    }
+
+    pipeline = (ST_PIPELINE *) calloc(1, sizeof(ST_PIPELINE));
+
+    retValue = (pipeline) ? ERR_DEFAULT : ERR_OUT_OF_MEMORY;
+
+    if (pipeline && regular && source.format == FORMAT_PLAIN)
+    {
+        retValue = map(source.fd, data);
+    }
+
+    if (pipeline && retValue)
+    {
+        pipeline->source = &source;
+
+        retValue = reserve(data, &pipeline->capacity);
+    }
+
+    if (!retValue)
+    {
+        pipeline->log = data;
+
+        pipeline->jobs = pool->jobs;
+
+        QUEUE_init(&pipeline->input);
+
+        for (i = 0; i < pipeline->jobs; i++)
+        {
+            QUEUE_init(&pipeline->task[i]);
+        }
+
+        if (pthread_create(&thread[1], NULL, splitter, pipeline))
+        {
+            QUEUE_free(&pipeline->input);
+
+            for (i = 0; i < pipeline->jobs; i++)
+            {
+                QUEUE_free(&pipeline->task[i]);
+            }
+
+            if (pipeline->source)
+            {
+                munmap(data->buffer, pipeline->capacity + 1);
+
+                data->buffer = NULL;
+
+                data->mapped = 0;
+            }
+
+            retValue = ERR_DEFAULT;
+        }
+    }
+
+    if (retValue) /* One step after the other */
+    {
+        free(pipeline);
+
+        retValue = (data->buffer) ? ERR_NONE : load(&source, data); /* Unless mapped */
+
+        SOURCE_close(&source);
+
+        return (retValue) ? retValue : evaluate(data, pool);
+    }
+
+    reading = (pthread_create(&thread[0], NULL, reader, pipeline)) ? 0 : 1;
+
+    if (!reading)
+    {
+        pipeline->readValue = ERR_DEFAULT;
+
+        QUEUE_push(&pipeline->input, NULL); /* Ends the splitter */
+    }
+
+    POOL_run(pool, aggregator, pipeline, pipeline->jobs);
+
+    pthread_join(thread[1], NULL);
+
+    if (reading)
+    {
+        pthread_join(thread[0], NULL);
+    }
+
+    if (pipeline->full) /* Read on one step after the other */
+    {
+        for (task = pipeline->first; task; task = task->next)
+        {
+            MATCH_free(&task->match);
+        }
+
+        clear(data);
+
+        QUEUE_free(&pipeline->input);
+
+        for (i = 0; i < pipeline->jobs; i++)
+        {
+            QUEUE_free(&pipeline->task[i]);
+        }
+
+        ARENA_free(&pipeline->arena);
+
+        free(pipeline);
+
+        retValue = load(&source, data);
+
+        SOURCE_close(&source);
+
+        return (retValue) ? retValue : evaluate(data, pool);
+    }
+
+    SOURCE_close(&source);
+
+    if (pipeline->source) /* Unused reserved range is given back */
+    {
+        page = sysconf(_SC_PAGESIZE);
+
+        keep = (data->size + 1 + (unsigned long) page - 1) / (unsigned long) page * (unsigned long) page;
+
+        if (keep < pipeline->capacity + 1)
+        {
+            munmap(data->buffer + keep, pipeline->capacity + 1 - keep);
+        }
+    }
+
+    retValue = pipeline->readValue;
+
+    if (!retValue && !data->size)
+    {
+        retValue = ERR_FILE_EMPTY;
+    }
+
+    retValue = (retValue) ? retValue : pipeline->splitValue;
+
+    for (task = pipeline->first; task; task = task->next)
+    {
+        if (append(data, &match))
+        {
+            MATCH_free(&task->match);
+
+            retValue = (retValue) ? retValue : ERR_OUT_OF_MEMORY;
+
+            continue;
+        }
+
+        *match = task->match;
+
+        retValue = (retValue) ? retValue : task->retValue; /* First failure, in log order */
+    }
+
+    if (!retValue && !data->matchCount)
+    {
+        retValue = ERR_MATCH_NOT_FOUND;
+    }
+
+    if (retValue)
+    {
+        clear(data);
+    }
+
+    QUEUE_free(&pipeline->input);
+
+    for (i = 0; i < pipeline->jobs; i++)
+    {
+        QUEUE_free(&pipeline->task[i]);
+    }
+
+    ARENA_free(&pipeline->arena);
+
+    free(pipeline);
+
+    return retValue;
+}
+
+/**
+ * @brief Pipeline reader thread: hands the splitter the end of the bytes
+ * read so far, LOG_CHUNK_SIZE bytes at a time, then NULL. A mapped log is
+ * only faulted in, a page at a time, ahead of the splitter; other sources
+ * are read into the reserved range.
+ * 
+ * @param argument ST_PIPELINE
+ * 
+ * @return void * NULL
+ */
+static void *
+reader(void *argument)
+{
+    ST_LOG *data;
+    ST_PIPELINE *pipeline;
+    long int page;
+    int retValue;
+    unsigned long count;
+    unsigned long end;
+    unsigned long i;
+
+    pipeline = (ST_PIPELINE *) argument;
+
+    data = pipeline->log;
+
+    retValue = ERR_NONE;
+
+    if (!pipeline->source)
+    {
+        page = sysconf(_SC_PAGESIZE);
+
+        for (end = 0; end < data->size; )
+        {
+            i = end;
+
+            end = (data->size - end > LOG_CHUNK_SIZE) ? end + LOG_CHUNK_SIZE : data->size;
+
+            for (; i < end; i += (unsigned long) page)
+            {
+                (void) *(volatile const char *) (data->buffer + i); /* Page fault */
+            }
+
+            QUEUE_push(&pipeline->input, data->buffer + end);
+        }
+    }
+    else
+    {
+        while (1)
+        {
+            if (data->size == pipeline->capacity)
+            {
+                pipeline->full = 1;
+
+                retValue = ERR_OUT_OF_MEMORY; /* Stops the splitter */
+
+                break;
+            }
+
+            count = pipeline->capacity - data->size;
+
+            retValue = SOURCE_read(pipeline->source, data->buffer + data->size, (count > LOG_CHUNK_SIZE) ? LOG_CHUNK_SIZE : count, &count);
+
+            if (retValue || !count)
+            {
+                break;
+            }
+
+            data->size += count;
+
+            QUEUE_push(&pipeline->input, data->buffer + data->size);
+        }
+    }
+
+    pipeline->readValue = retValue;
+
+    QUEUE_push(&pipeline->input, NULL);
+
+    return NULL;
+}
+
+/**
+ * @brief Reserves the address range of a log read through the pipeline.
+ * Pages are only backed once written, and the byte after the content reads
+ * as '\0' (a fresh page). LOG_RESERVE_SIZE is tried first, then halves of
+ * it down to LOG_RESERVE_MINIMUM (e.g. with vm.overcommit_memory=2, where
+ * the whole range is committed).
+ * 
+ * @param data log file structure
+ * @param capacity bytes available for the content
+ * 
+ * @return int ERR_xxx
+ */
+static int
+reserve(ST_LOG *data, unsigned long *capacity)
+{
+    void *address;
+    unsigned long size;
+
+    size = LOG_RESERVE_SIZE;
+
+    while ((address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)) == MAP_FAILED)
+    {
+        if (size / 2 < LOG_RESERVE_MINIMUM)
+        {
+            return ERR_OUT_OF_MEMORY;
+        }
+
+        size /= 2;
+    }
+
+    data->buffer = (char *) address;
+
+    data->size = 0;
+
+    data->mapped = 1;
+
+    *capacity = size - 1; /* NUL-terminated */
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Finds the match boundaries of a log, up to a limit: a match is
+ * opened by QLP_KEY_MATCH and closed by QLP_KEY_SHUTDOWN, by the next
+ * QLP_KEY_MATCH or by EOF. As in EVENT_next(), only the first key of a
+ * line counts. Only these two keys are looked for, so this pass is much
+ * cheaper than the tokenization of the matches. It resumes where the
+ * previous call stopped, so a log can be split while it is read, as long
+ * as the limit ends a line.
+ * 
+ * @param data log file structure
+ * @param state split state (zeroed, callback set, before the first call)
+ * @param limit end of the bytes to be scanned
+ * @param eof no bytes follow limit (the open match is closed)
+ * 
+ * @return int ERR_xxx
+ */
+static int
+split(ST_LOG *data, ST_SPLIT *state, unsigned long limit, int eof)
+{
+    const char *end;
+    const char *line;
+    const char *pointer;
+    int first;
+    int key;
+    int retValue;
+
+    while (state->offset < limit)
+    {
+        pointer = SCAN_next(data->buffer + state->offset, limit - state->offset, SCAN_MATCH | SCAN_SHUTDOWN, &key);
+
+        if (!pointer)
+        {
+            state->offset = limit;
+
+            break;
+        }
+
+        line = pointer;
+
+        while (line > data->buffer && line[-1] != '\n')
+        {
+            line--; /* Line start */
+        }
+
+        end = (const char *) memchr(pointer, '\n', (size_t) (data->buffer + limit - pointer));
+
+        state->offset = (end) ? (unsigned long) (end - data->buffer) : limit; /* Next line */
+
+        if (line < pointer && SCAN_next(line, (unsigned long) (data->buffer + limit - line), SCAN_KILL | SCAN_MATCH | SCAN_PLAYER | SCAN_SHUTDOWN, &first) != pointer)
+        {
+            continue; /* Not the first key of its line */
+        }
+
+        if (state->opened)
+        {
+            state->opened = 0;
+
+            retValue = state->close(state->context, state->open, (unsigned long) (pointer - data->buffer) - state->open);
+
+            if (retValue)
+            {
+                return retValue;
+            }
+        }
+
+        if (key == SCAN_SHUTDOWN)
+        {
+            continue;
+        }
+
+        state->opened = 1;
+
+        state->open = (unsigned long) (pointer - data->buffer);
+    }
+
+    if (eof && state->opened) /* Up to EOF */
+    {
+        state->opened = 0;
+
+        return state->close(state->context, state->open, limit - state->open);
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Pipeline splitter thread: splits the log as the reader brings it
+ * in (complete lines only) and hands every closed match to an aggregator
+ * (dispatch()). Once the reader is done, each aggregator gets a NULL match.
+ * 
+ * @param argument ST_PIPELINE
+ * 
+ * @return void * NULL
+ */
+static void *
+splitter(void *argument)
+{
+    ST_LOG *data;
+    ST_PIPELINE *pipeline;
+    ST_SPLIT state;
+    const char *end;
+    int i;
+    int retValue;
+    unsigned long limit;
+    unsigned long ready;
+
+    pipeline = (ST_PIPELINE *) argument;
+
+    data = pipeline->log;
+
+    memset(&state, 0, sizeof(ST_SPLIT));
+
+    state.close = dispatch;
+
+    state.context = pipeline;
+
+    retValue = ERR_NONE;
+
+    ready = 0;
+
+    while ((end = (const char *) QUEUE_pop(&pipeline->input)))
+    {
+        ready = (unsigned long) (end - data->buffer);
+
+        for (limit = ready; limit > state.offset && data->buffer[limit - 1] != '\n'; limit--);
+
+        if (!retValue)
+        {
+            retValue = split(data, &state, limit, 0); /* On failure, the reader is still drained */
+        }
+    }
+
+    if (!retValue && !pipeline->readValue)
+    {
+        retValue = split(data, &state, ready, 1);
+    }
+
+    pipeline->splitValue = retValue;
+
+    for (i = 0; i < pipeline->jobs; i++)
+    {
+        QUEUE_push(&pipeline->task[i], NULL);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Split callback: appends a match to the log match list.
+ * 
+ * @param context ST_LOG
+ * @param offset offset of the match stream
+ * @param size size of match stream
+ * 
+ * @return int ERR_xxx
+ */
+static int
+store(void *context, unsigned long offset, unsigned long size)
+{
+    ST_LOG *data;
+    ST_MATCH *match;
+    int retValue;
+
+    data = (ST_LOG *) context;
+
+    retValue = append(data, &match);
+
+    if (retValue)
+    {
+        return retValue;
+    }
+
+    return MATCH_import(offset, size, &data->arena, match);
+}
+
+/**
+ * @brief Tokenizes a match span and aggregates every event but the opening
+ * EVENT_MATCH into the match report. Matches share nothing but the
+ * (read-only) log buffer, so any number of them can be evaluated at once.
+ * 
+ * @param buffer log buffer
+ * @param match match structure
+ * 
+ * @return int ERR_xxx
+ */
+static int
+tokenize(const char *buffer, ST_MATCH *match)
+{
+    ST_EVENT event;
+    int retValue;
+    unsigned long offset;
+
+    offset = match->offset;
+
+    retValue = ERR_NONE;
+
+    while (!retValue && EVENT_next(buffer, match->offset + match->size, &offset, &event))
+    {
+        if (event.type == EVENT_MATCH || event.type == EVENT_SHUTDOWN)
+        {
+            continue;
+        }
+
+        retValue = MATCH_event(match, buffer + event.offset, &event);
+    }
+
+    if (!retValue && !match->report->player) /* No players found */
+    {
+        retValue = ERR_INVALID_ARGUMENT;
+    }
+
+    return retValue;
 }
@@ -12,19 +12,28 @@
 
 #include "qlp.h"
 
+/********************/
+/* Type definitions */
+/********************/
+
+struct POOL; /* pool.h */
+
 /********************/
 /* Public functions */
 /********************/
 
 /**
- * @brief Evaluates the content of a previously imported log file.
+ * @brief Evaluates the content of a previously imported log file. Only the
+ * given log and pool are touched, so distinct logs can be evaluated at
+ * once from distinct threads, each with its own pool.
  * 
  * @param[in,out] data log file structure
+ * @param[in,out] pool threads matches are spread over
  * 
  * @return int ERR_xxx
  */
 extern int
-LOG_evaluate(ST_LOG *data);
+LOG_evaluate(ST_LOG *data, struct POOL *pool);
 
 /**
  * @brief Imports a log file.
@@ -37,6 +46,22 @@ LOG_evaluate(ST_LOG *data);
 extern int
 LOG_import(const char *file, ST_LOG *data);
 
+/**
+ * @brief Imports and evaluates a log file at once, as LOG_import() then
+ * LOG_evaluate() would, through a pipeline: the log is read, split into
+ * matches and aggregated by distinct threads at the same time, so I/O and
+ * decompression overlap with the evaluation. Only the given log and pool
+ * are touched.
+ *
+ * @param[in] file file name
+ * @param[out] data log file structure
+ * @param[in,out] pool threads matches are aggregated by
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+LOG_parse(const char *file, ST_LOG *data, struct POOL *pool);
+
 /**
  * @brief Initializes the LOG API.
  *
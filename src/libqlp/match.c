@@ -9,26 +9,16 @@
 
 #include "match.h"
 
-#include <semaphore.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/********************/
-/* Global variables */
-/********************/
-
-static sem_t semaphore;
-
 /***********************/
 /* Function prototypes */
 /***********************/
 
 static int
-evaluate(ST_MATCH **data);
-
-static int
-import(const char *stream, unsigned long size, ST_MATCH **data);
+import(unsigned long offset, unsigned long size, ST_ARENA *arena, ST_MATCH *data);
 
 /********************/
 /* Public functions */
@@ -36,58 +26,68 @@ import(const char *stream, unsigned long size, ST_MATCH **data);
 
 /**
  * @brief @ref match.h
- * 
- * @param[in,out] data match file structure
- * 
+ *
+ * @param[in,out] data match structure
+ * @param[in] stream event key (origin of its fields)
+ * @param[in] event event structure
+ *
  * @return int ERR_xxx
  */
 extern int
-MATCH_evaluate(ST_MATCH **data)
+MATCH_event(ST_MATCH *data, const char *stream, const ST_EVENT *event)
 {
-    int retValue;
-
-    LIBQLP_TRACE("data [%lu]", data);
+    if (!data || !stream || !event)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
 
-    sem_wait(&semaphore);
+    return REPORT_event(data->report, stream, event);
+}
 
-    retValue = ERR_INVALID_ARGUMENT;
+/**
+ * @brief @ref match.h
+ *
+ * @param[in,out] data match structure
+ */
+extern void
+MATCH_free(ST_MATCH *data)
+{
+    LIBQLP_TRACE("data [%lu]", data);
 
-    if (data)
+    if (!data)
     {
-        retValue = evaluate(data);
+        return;
     }
 
-    LIBQLP_TRACE("retValue [%d]", retValue);
-
-    sem_post(&semaphore);
+    if (data->report)
+    {
+        REPORT_free(data->report);
+    }
 
-    return retValue;
+    memset(data, 0, sizeof(ST_MATCH));
 }
 
 /**
  * @brief @ref match.h
  *
- * @param[in] stream match buffer
+ * @param[in] offset offset of the match stream
  * @param[in] size size of match stream
- * @param[out] data match stream structure
+ * @param[in,out] arena where the report is allocated from
+ * @param[out] data match structure
  * 
  * @return int ERR_xxx
  */
 extern int
-MATCH_import(const char *stream, unsigned long size, ST_MATCH **data)
+MATCH_import(unsigned long offset, unsigned long size, ST_ARENA *arena, ST_MATCH *data)
 {
     int retValue;
 
-    LIBQLP_TRACE("*stream [%.32s...], size [%lu], data [%lu]", (stream) ? stream : "(null)", size, data);
+    LIBQLP_TRACE("offset [%lu], size [%lu], arena [%lu], data [%lu]", offset, size, arena, data);
 
-    sem_wait(&semaphore);
-
-    retValue = import(stream, size, data);
+    retValue = import(offset, size, arena, data);
 
     LIBQLP_TRACE("retValue [%d]", retValue);
 
-    sem_post(&semaphore);
-
     return retValue;
 }
 
@@ -106,13 +106,6 @@ MATCH_start(void)
         return ERR_ALREADY_STARTED;
     }
 
-    if (KILL_start())
-    {
-        return ERR_DEFAULT;
-    }
-
-    sem_init(&semaphore, 0, 1);
-
     return ERR_NONE;
 }
 
@@ -121,125 +114,42 @@ MATCH_start(void)
 /*********************/
 
 /**
- * @brief @ref MATCH_evaluate()
+ * @brief @ref MATCH_import()
  * 
- * @param data match file structure
+ * @param offset offset of the match stream
+ * @param size size of match stream
+ * @param arena where the report is allocated from
+ * @param data match structure
  * 
  * @return int ERR_xxx
  */
 static int
-evaluate(ST_MATCH **data)
+import(unsigned long offset, unsigned long size, ST_ARENA *arena, ST_MATCH *data)
 {
-    ST_KILL **kill;
-    char *begin;
-    char *end;
     int retValue;
-    unsigned long size;
-
-    if (!data)
-    {
-        return ERR_INVALID_ARGUMENT;
-    }
 
-    if (!(*data)->buffer)
+    if (!size || !arena || !data)
     {
         return ERR_INVALID_ARGUMENT;
     }
 
-    kill = &((*data)->kill);
-
-    begin = (*data)->buffer;
-
-    while (begin)
-    {
-        begin = strstr(begin, QLP_KEY_KILL);
-
-        if (!begin)
-        {
-            break;
-        }
-
-        end = strstr(begin + strlen(QLP_KEY_KILL), QLP_KEY_KILL);
+    data->offset = offset;
 
-        if (!end)
-        {
-            end = begin;
-        }
+    data->size = size;
 
-        size = strlen(begin) - strlen(end);
+    data->report = (ST_MATCH_REPORT *) ARENA_alloc(arena, sizeof(ST_MATCH_REPORT));
 
-        if (!size)
-        {
-            size = strlen(begin);
-        }
-
-        retValue = KILL_import(begin, size, kill);
-
-        if (retValue)
-        {
-            return retValue;
-        }
-
-        kill = &(*kill)->next;
-
-        if (begin != end)
-        {
-            begin = end;
-        }
-        else
-        {
-            begin = NULL; /* EOF */
-        }
-    }
-
-    return ERR_NONE; /* Kills aren't mandatory */
-}
-
-/**
- * @brief @ref MATCH_import()
- * 
- * @param stream match buffer
- * @param size size of match stream
- * @param data match stream structure
- * 
- * @return int ERR_xxx
- */
-static int
-import(const char *stream, unsigned long size, ST_MATCH **data)
-{
-    if (!stream || (size <= 0))
-    {
-        return ERR_INVALID_ARGUMENT;
-    }
-
-    if (!data)
-    {
-        return ERR_INVALID_ARGUMENT;
-    }
-
-    (*data) = (ST_MATCH *) malloc(sizeof(ST_MATCH));
-
-    if (!(*data))
+    if (!data->report)
     {
         return ERR_OUT_OF_MEMORY;
     }
 
-    (*data)->buffer = (char *) malloc(sizeof(char) * (size + 1));
+    retValue = REPORT_init(data->report);
 
-    if (!((*data)->buffer))
+    if (retValue)
     {
-        free(*data);
-
-        return ERR_OUT_OF_MEMORY;
+        data->report = NULL; /* Left to the arena */
     }
 
-    (*data)->next = NULL;
-
-    (*data)->kill = NULL;
-
-    memcpy((*data)->buffer, stream, size);
-
-    (*data)->buffer[size] = 0;
-
-    return ERR_NONE;
+    return retValue;
 }
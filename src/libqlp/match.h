@@ -12,31 +12,52 @@
 
 #include "qlp.h"
 
+/********************/
+/* Type definitions */
+/********************/
+
+struct EVENT; /* event.h */
+
 /********************/
 /* Public functions */
 /********************/
 
 /**
- * @brief Evaluates the content of a previously imported match stream.
- * 
- * @param[in,out] data match file structure
+ * @brief Imports a match span of the log buffer (no copy is made), along
+ * with an empty report allocated from an arena.
+ *
+ * @param[in] offset offset of the match stream
+ * @param[in] size size of match stream
+ * @param[in,out] arena where the report is allocated from
+ * @param[out] data match structure
  * 
  * @return int ERR_xxx
  */
 extern int
-MATCH_evaluate(ST_MATCH **data);
+MATCH_import(unsigned long offset, unsigned long size, ST_ARENA *arena, ST_MATCH *data);
 
 /**
- * @brief Imports a match stream.
+ * @brief Aggregates an event into the report of a match (see
+ * REPORT_event()). Only the given match is touched, so distinct matches can
+ * be fed from distinct threads.
+ *
+ * @param[in,out] data match structure
+ * @param[in] stream event key (origin of its fields)
+ * @param[in] event event structure
  *
- * @param[in] stream match buffer
- * @param[in] size size of match stream
- * @param[out] data match stream structure
- * 
  * @return int ERR_xxx
  */
 extern int
-MATCH_import(const char *stream, unsigned long size, ST_MATCH **data);
+MATCH_event(ST_MATCH *data, const char *stream, const struct EVENT *event);
+
+/**
+ * @brief Safely deallocates memory from the given input (the report itself
+ * is released along with its arena).
+ *
+ * @param[in,out] data match structure
+ */
+extern void
+MATCH_free(ST_MATCH *data);
 
 /**
  * @brief Initializes the MATCH API.
@@ -0,0 +1,327 @@
+/**
+ * @file name.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief NAME API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "name.h"
+
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#define NAME_TABLE_SIZE 256 /* Initial */
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef struct NAME
+{
+    unsigned int hash;
+    int id;
+    int lenght;
+    char string[]; /* NUL-terminated */
+} ST_NAME;
+
+typedef struct NAME_TABLE
+{
+    struct NAME_TABLE *previous; /* Replaced by this one, kept for late readers */
+    int size; /* Power of 2, kept at most half full */
+    ST_NAME *slot[]; /* Open addressing (NULL if empty) */
+} ST_NAME_TABLE;
+
+/********************/
+/* Global variables */
+/********************/
+
+static sem_t semaphore; /* Taken by writers only */
+
+static ST_NAME_TABLE *names; /* Published with release stores */
+
+static int count; /* Of interned names (writers only) */
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static ST_NAME *
+find(ST_NAME_TABLE *table, const char *name, int lenght, unsigned int hash, unsigned int *index);
+
+static unsigned int
+hashName(const char *name, int lenght);
+
+static int
+intern(const char *name, int lenght, unsigned int hash, ST_NAME **entry);
+
+static ST_NAME_TABLE *
+newTable(int size);
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref name.h
+ *
+ * @param[in] name autodescriptive (needs not to be NUL-terminated)
+ * @param[in] lenght lenght of name
+ * @param[out] id name ID
+ * @param[out] string interned NUL-terminated copy (optional)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+NAME_intern(const char *name, int lenght, int *id, const char **string)
+{
+    ST_NAME *entry;
+    unsigned int hash;
+    unsigned int index;
+    int retValue;
+
+    LIBQLP_TRACE("name [%lu], lenght [%d], id [%lu], string [%lu]", name, lenght, id, string);
+
+    if (!name || lenght < 0 || !id)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    hash = hashName(name, lenght);
+
+    retValue = ERR_NONE;
+
+    entry = find(__atomic_load_n(&names, __ATOMIC_ACQUIRE), name, lenght, hash, &index);
+
+    if (!entry) /* New name, or one published meanwhile */
+    {
+        sem_wait(&semaphore);
+
+        retValue = intern(name, lenght, hash, &entry);
+
+        sem_post(&semaphore);
+    }
+
+    if (!retValue)
+    {
+        *id = entry->id;
+
+        if (string)
+        {
+            *string = entry->string;
+        }
+    }
+
+    LIBQLP_TRACE("retValue [%d]", retValue);
+
+    return retValue;
+}
+
+/**
+ * @brief @ref name.h
+ *
+ * @return int ERR_xxx
+ */
+extern int
+NAME_start(void)
+{
+    static int start = -1;
+
+    if (!start)
+    {
+        return ERR_ALREADY_STARTED;
+    }
+
+    names = newTable(NAME_TABLE_SIZE);
+
+    if (!names)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    count = 0;
+
+    sem_init(&semaphore, 0, 1);
+
+    return ERR_NONE;
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Looks a name up (linear probing). Takes no lock: slots are only
+ * ever filled, with entries complete before they are published.
+ *
+ * @param table name table
+ * @param name autodescriptive
+ * @param lenght lenght of name
+ * @param hash hashName() of name
+ * @param index slot holding the name, or the empty slot it would take
+ *
+ * @return ST_NAME * entry, or NULL if the name is not in table
+ */
+static ST_NAME *
+find(ST_NAME_TABLE *table, const char *name, int lenght, unsigned int hash, unsigned int *index)
+{
+    ST_NAME *entry;
+    unsigned int i;
+    unsigned int mask;
+
+    mask = (unsigned int) table->size - 1;
+
+    for (i = hash & mask; ; i = (i + 1) & mask)
+    {
+        entry = __atomic_load_n(&table->slot[i], __ATOMIC_ACQUIRE);
+
+        if (!entry || (entry->hash == hash && entry->lenght == lenght && !memcmp(entry->string, name, lenght)))
+        {
+            break;
+        }
+    }
+
+    *index = i;
+
+    return entry;
+}
+
+/**
+ * @brief Hashes a name (FNV-1a).
+ *
+ * @param name autodescriptive
+ * @param lenght lenght of name
+ *
+ * @return unsigned int hash
+ */
+static unsigned int
+hashName(const char *name, int lenght)
+{
+    unsigned int value;
+    int i;
+
+    value = 2166136261u;
+
+    for (i = 0; i < lenght; i++)
+    {
+        value = (value ^ (unsigned char) name[i]) * 16777619u;
+    }
+
+    return value;
+}
+
+/**
+ * @brief @ref NAME_intern(), once the lock-free lookup missed (the caller
+ * holds the lock). A table about to get more than half full is replaced by
+ * one twice as large, published once filled; the old one is never freed,
+ * since readers may still be walking it.
+ *
+ * @param name autodescriptive
+ * @param lenght lenght of name
+ * @param hash hashName() of name
+ * @param entry new or existing entry
+ *
+ * @return int ERR_xxx
+ */
+static int
+intern(const char *name, int lenght, unsigned int hash, ST_NAME **entry)
+{
+    ST_NAME_TABLE *table;
+    ST_NAME *pointer;
+    unsigned int index;
+    unsigned int mask;
+    int i;
+
+    table = names;
+
+    *entry = find(table, name, lenght, hash, &index);
+
+    if (*entry)
+    {
+        return ERR_NONE; /* Interned by another thread meanwhile */
+    }
+
+    pointer = (ST_NAME *) malloc(sizeof(ST_NAME) + lenght + 1);
+
+    if (!pointer)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    memcpy(pointer->string, name, lenght);
+
+    pointer->string[lenght] = 0;
+
+    pointer->lenght = lenght;
+
+    pointer->hash = hash;
+
+    pointer->id = count;
+
+    if ((count + 1) * 2 > table->size)
+    {
+        table = newTable(table->size * 2);
+
+        if (!table)
+        {
+            free(pointer);
+
+            return ERR_OUT_OF_MEMORY;
+        }
+
+        mask = (unsigned int) table->size - 1;
+
+        for (i = 0; i < names->size; i++)
+        {
+            if (names->slot[i])
+            {
+                for (index = names->slot[i]->hash & mask; table->slot[index]; index = (index + 1) & mask);
+
+                table->slot[index] = names->slot[i];
+            }
+        }
+
+        table->previous = names;
+
+        __atomic_store_n(&names, table, __ATOMIC_RELEASE);
+
+        find(table, name, lenght, hash, &index);
+    }
+
+    __atomic_store_n(&table->slot[index], pointer, __ATOMIC_RELEASE);
+
+    count += 1;
+
+    *entry = pointer;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Allocates an empty name table.
+ *
+ * @param size number of slots (power of 2)
+ *
+ * @return ST_NAME_TABLE * autodescriptive (NULL if out of memory)
+ */
+static ST_NAME_TABLE *
+newTable(int size)
+{
+    ST_NAME_TABLE *table;
+
+    table = (ST_NAME_TABLE *) calloc(1, sizeof(ST_NAME_TABLE) + sizeof(ST_NAME *) * size);
+
+    if (table)
+    {
+        table->size = size;
+    }
+
+    return table;
+}
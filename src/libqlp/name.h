@@ -0,0 +1,44 @@
+/**
+ * @file name.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _NAME_H_INCLUDED_
+#define _NAME_H_INCLUDED_
+
+#include "qlp.h"
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Interns a name: every distinct name is copied once per process and
+ * given a dense ID (0, 1, 2...). Interned strings are never moved nor freed,
+ * so they can be kept and compared by ID from any thread. Names already
+ * interned are found without any lock; only a name never seen before takes
+ * the (process-wide) lock to be added.
+ *
+ * @param[in] name autodescriptive (needs not to be NUL-terminated)
+ * @param[in] lenght lenght of name
+ * @param[out] id name ID
+ * @param[out] string interned NUL-terminated copy (optional)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+NAME_intern(const char *name, int lenght, int *id, const char **string);
+
+/**
+ * @brief Initializes the NAME API.
+ *
+ * @return int ERR_xxx
+ */
+extern int
+NAME_start(void);
+
+#endif /* #ifndef _NAME_H_INCLUDED_ */
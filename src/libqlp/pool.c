@@ -0,0 +1,320 @@
+/**
+ * @file pool.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief POOL API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static void
+drain(ST_POOL *data, int self);
+
+static int
+take(ST_POOL *data, int owner, int steal);
+
+static void *
+worker(void *argument);
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref pool.h
+ *
+ * @param[in,out] data pool structure
+ */
+extern void
+POOL_free(ST_POOL *data)
+{
+    int i;
+
+    LIBQLP_TRACE("data [%lu]", data);
+
+    if (!data)
+    {
+        return;
+    }
+
+    data->quit = 1;
+
+    for (i = 0; i < data->threads; i++)
+    {
+        sem_post(&data->work);
+    }
+
+    for (i = 0; i < data->threads; i++)
+    {
+        pthread_join(data->thread[i], NULL);
+    }
+
+    sem_destroy(&data->done);
+
+    sem_destroy(&data->lock);
+
+    sem_destroy(&data->work);
+
+    for (i = 0; i < POOL_MAX_JOBS; i++)
+    {
+        sem_destroy(&data->deque[i].lock);
+    }
+
+    memset(data, 0, sizeof(ST_POOL));
+}
+
+/**
+ * @brief @ref pool.h
+ *
+ * @param[out] data pool structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+POOL_init(ST_POOL *data)
+{
+    int i;
+
+    LIBQLP_TRACE("data [%lu]", data);
+
+    if (!data)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    memset(data, 0, sizeof(ST_POOL));
+
+    data->jobs = 1;
+
+    sem_init(&data->done, 0, 0);
+
+    sem_init(&data->lock, 0, 1);
+
+    sem_init(&data->work, 0, 0);
+
+    for (i = 0; i < POOL_MAX_JOBS; i++)
+    {
+        sem_init(&data->deque[i].lock, 0, 1);
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref pool.h
+ *
+ * @param[in,out] data pool structure
+ * @param[in] jobs number of threads (1 runs every task in the caller)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+POOL_jobs(ST_POOL *data, int jobs)
+{
+    int retValue;
+
+    LIBQLP_TRACE("data [%lu], jobs [%d]", data, jobs);
+
+    if (!data || jobs < 1 || jobs > POOL_MAX_JOBS)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    retValue = ERR_NONE;
+
+    while (data->threads < jobs - 1)
+    {
+        if (pthread_create(&data->thread[data->threads], NULL, worker, data))
+        {
+            retValue = ERR_DEFAULT;
+
+            break;
+        }
+
+        data->threads += 1;
+    }
+
+    data->jobs = data->threads + 1;
+
+    data->jobs = (data->jobs < jobs) ? data->jobs : jobs;
+
+    LIBQLP_TRACE("retValue [%d]", retValue);
+
+    return retValue;
+}
+
+/**
+ * @brief @ref pool.h
+ *
+ * @param[in,out] data pool structure
+ * @param[in] task autodescriptive
+ * @param[in] context task argument
+ * @param[in] count number of tasks
+ *
+ * @return int ERR_xxx
+ */
+extern int
+POOL_run(ST_POOL *data, PF_TASK task, void *context, int count)
+{
+    int helpers;
+    int i;
+
+    LIBQLP_TRACE("data [%lu], task [%lu], context [%lu], count [%d]", data, task, context, count);
+
+    if (!data || !task || count < 0)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (!count)
+    {
+        return ERR_NONE;
+    }
+
+    data->task = task;
+
+    data->context = context;
+
+    data->width = (data->jobs < count) ? data->jobs : count;
+
+    for (i = 0; i < data->width; i++)
+    {
+        data->deque[i].head = 0;
+
+        data->deque[i].tail = (count - i + data->width - 1) / data->width;
+    }
+
+    data->joined = 1; /* The caller owns deque 0 */
+
+    helpers = data->width - 1;
+
+    for (i = 0; i < helpers; i++)
+    {
+        sem_post(&data->work);
+    }
+
+    drain(data, 0);
+
+    for (i = 0; i < helpers; i++)
+    {
+        sem_wait(&data->done);
+    }
+
+    return ERR_NONE;
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Runs tasks of the current run until none is left: first the ones
+ * of its own deque, then the ones stolen from the others.
+ *
+ * @param data pool structure
+ * @param self deque owned by the calling thread
+ */
+static void
+drain(ST_POOL *data, int self)
+{
+    int i;
+    int index;
+
+    while (1)
+    {
+        index = take(data, self, 0);
+
+        for (i = 1; index < 0 && i < data->width; i++)
+        {
+            index = take(data, (self + i) % data->width, 1);
+        }
+
+        if (index < 0)
+        {
+            break; /* Tasks spawn no tasks: nothing is left */
+        }
+
+        data->task(data->context, index);
+    }
+}
+
+/**
+ * @brief Takes a task from a deque: the first one left by its owner, the
+ * last one left by any other thread.
+ *
+ * @param data pool structure
+ * @param owner deque
+ * @param steal 1 if the caller does not own the deque
+ *
+ * @return int task index, -1 if the deque is empty
+ */
+static int
+take(ST_POOL *data, int owner, int steal)
+{
+    ST_POOL_DEQUE *deque;
+    int slot;
+
+    deque = &data->deque[owner];
+
+    slot = -1;
+
+    sem_wait(&deque->lock);
+
+    if (deque->head < deque->tail)
+    {
+        slot = (steal) ? --deque->tail : deque->head++;
+    }
+
+    sem_post(&deque->lock);
+
+    return (slot < 0) ? -1 : slot * data->width + owner;
+}
+
+/**
+ * @brief Worker thread: joins every run it is woken up for, until its pool
+ * is freed.
+ *
+ * @param argument pool structure
+ *
+ * @return void * NULL
+ */
+static void *
+worker(void *argument)
+{
+    ST_POOL *data;
+    int self;
+
+    data = (ST_POOL *) argument;
+
+    while (1)
+    {
+        while (sem_wait(&data->work));
+
+        if (data->quit)
+        {
+            break;
+        }
+
+        sem_wait(&data->lock);
+
+        self = data->joined++;
+
+        sem_post(&data->lock);
+
+        drain(data, self);
+
+        sem_post(&data->done);
+    }
+
+    return NULL;
+}
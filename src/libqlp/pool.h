@@ -0,0 +1,108 @@
+/**
+ * @file pool.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _POOL_H_INCLUDED_
+#define _POOL_H_INCLUDED_
+
+#include "qlp.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#define POOL_MAX_JOBS QLP_MAX_JOBS
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef void (*PF_TASK)(void *context, int index);
+
+typedef struct POOL_DEQUE
+{
+    int head; /* Next slot taken by its owner */
+    int tail; /* End of the slots, where other threads steal from */
+    sem_t lock; /* Guards head and tail */
+} ST_POOL_DEQUE;
+
+typedef struct POOL
+{
+    PF_TASK task;
+    void *context;
+    int jobs; /* Threads per run, the caller included */
+    int joined; /* Threads of the current run so far (deque owners) */
+    int quit; /* Workers are leaving (POOL_free()) */
+    int threads; /* Worker threads created so far */
+    int width; /* Threads (and deques) of the current run */
+    sem_t done; /* Posted by each worker once a run is drained */
+    sem_t lock; /* Guards joined */
+    sem_t work; /* Posted once per worker needed by a run */
+    ST_POOL_DEQUE deque[POOL_MAX_JOBS]; /* Slot s of deque t is task s * width + t */
+    pthread_t thread[POOL_MAX_JOBS];
+} ST_POOL;
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Stops and joins the worker threads of a pool.
+ *
+ * @param[in,out] data pool structure
+ */
+extern void
+POOL_free(ST_POOL *data);
+
+/**
+ * @brief Initializes a pool with no worker threads (every task runs in the
+ * caller).
+ *
+ * @param[out] data pool structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+POOL_init(ST_POOL *data);
+
+/**
+ * @brief Sets the number of threads running POOL_run() tasks, the calling
+ * thread included. Missing worker threads are created on demand.
+ *
+ * @param[in,out] data pool structure
+ * @param[in] jobs number of threads (1 runs every task in the caller)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+POOL_jobs(ST_POOL *data, int jobs);
+
+/**
+ * @brief Runs task(context, i) for every i in [0, count) and waits for all
+ * of them. Indexes are dealt round robin to a deque per thread (thread t
+ * gets t, t + threads, ...), so each thread starts with one of the lowest
+ * indexes: callers put their costliest tasks first. A thread takes its own
+ * tasks in order and, once out of them, steals the last one left in
+ * another deque, so no thread idles while tasks are pending. A pool serves
+ * one caller at a time, and tasks must not call POOL_run() themselves;
+ * distinct pools share nothing.
+ *
+ * @param[in,out] data pool structure
+ * @param[in] task autodescriptive
+ * @param[in] context task argument
+ * @param[in] count number of tasks
+ *
+ * @return int ERR_xxx
+ */
+extern int
+POOL_run(ST_POOL *data, PF_TASK task, void *context, int count);
+
+#endif /* #ifndef _POOL_H_INCLUDED_ */
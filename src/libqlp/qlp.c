@@ -9,124 +9,47 @@
 
 #include "qlp.h"
 
-#include "libcjson/cJSON.h"
-
+#include <fcntl.h>
 #include <semaphore.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-
-/**********/
-/* Macros */
-/**********/
-
-#define MEANS_OF_DEATH_LIST_SIZE \
-( \
-    (int) (sizeof(ST_KILL_MEAN) * TOTAL_MEANS_OF_DEATH) \
-)
-
-#define TOTAL_MEANS_OF_DEATH \
-( \
-    (int) (sizeof(meansOfDeath) / sizeof(ST_KILL_MEAN)) \
-)
+#include <sys/mman.h>
+#include <unistd.h>
 
 /********************/
 /* Type definitions */
 /********************/
 
-typedef struct KILL_MEAN
-{
-    char name[32];
-    int killCount;
-} ST_KILL_MEAN;
-
-typedef struct PLAYER_REPORT
-{
-    char *name;
-    int killCount;
-    struct PLAYER_REPORT *next;
-} ST_PLAYER_REPORT;
-
-typedef struct
+struct QLP_CONTEXT
 {
-    ST_KILL_MEAN *meanOfDeath;
-    ST_PLAYER_REPORT *player;
-    int killCount;
-} ST_MATCH_REPORT;
-
-typedef struct
-{
-    int matchCount;
-    ST_MATCH_REPORT *matchReport;
-} ST_REPORT;
-
-/**************/
-/* Constantes */
-/**************/
-
-static const ST_KILL_MEAN meansOfDeath[] =
-{
-    { "MOD_UNKNOWN", 0 },
-    { "MOD_SHOTGUN", 0 },
-    { "MOD_GAUNTLET", 0 },
-    { "MOD_MACHINEGUN", 0 },
-    { "MOD_GRENADE", 0 },
-    { "MOD_GRENADE_SPLASH", 0 },
-    { "MOD_ROCKET", 0 },
-    { "MOD_ROCKET_SPLASH", 0 },
-    { "MOD_PLASMA", 0 },
-    { "MOD_PLASMA_SPLASH", 0 },
-    { "MOD_RAILGUN", 0 },
-    { "MOD_LIGHTNING", 0 },
-    { "MOD_BFG", 0 },
-    { "MOD_BFG_SPLASH", 0 },
-    { "MOD_WATER", 0 },
-    { "MOD_SLIME", 0 },
-    { "MOD_LAVA", 0 },
-    { "MOD_CRUSH", 0 },
-    { "MOD_TELEFRAG", 0 },
-    { "MOD_FALLING", 0 },
-    { "MOD_SUICIDE", 0 },
-    { "MOD_TARGET_LASER", 0 },
-    { "MOD_TRIGGER_HURT", 0 },
-    { "MOD_NAIL", 0 },
-    { "MOD_CHAINGUN", 0 },
-    { "MOD_PROXIMITY_MINE", 0 },
-    { "MOD_KAMIKAZE", 0 },
-    { "MOD_JUICED", 0 },
-    { "MOD_GRAPPLE", 0 }
+    ST_POOL pool; /* QLP_setJobs_r() */
+    int compact; /* QLP_setCompact_r() */
+    volatile sig_atomic_t stop; /* QLP_stop_r() */
+    ST_JSON json; /* Report stream */
 };
 
 /********************/
 /* Global variables */
 /********************/
 
-static sem_t semaphore;
+static sem_t semaphore; /* Guards defaultContext */
+
+static ST_QLP_CONTEXT defaultContext; /* Behind the QLP_xxx() calls */
 
 /***********************/
 /* Function prototypes */
 /***********************/
 
-static int
-appendPlayer(ST_PLAYER_REPORT **list, char *name, int lenght);
-
 static int
 clearQLP(ST_QLP *data, int error);
 
 static int
-clearReport(ST_REPORT *data, int error);
+initContext(ST_QLP_CONTEXT *data);
 
 static int
-createJSON(ST_REPORT *report, cJSON **json);
-
-static int
-report(ST_QLP *data);
-
-static int
-updateMeanOfDeath(ST_KILL_MEAN *list, char *name);
-
-static int
-updatePlayer(ST_PLAYER_REPORT *list, char *name, int lenght, int count);
+report(ST_QLP_CONTEXT *context, ST_QLP *data, FILE *file, int fd);
 
 /********************/
 /* Public functions */
@@ -144,21 +67,39 @@ QLP_evaluate(ST_QLP *data)
 {
     int retValue;
 
-    LIBQLP_TRACE("data [%lu]", data);
-
     sem_wait(&semaphore);
 
+    retValue = QLP_evaluate_r(&defaultContext, data);
+
+    sem_post(&semaphore);
+
+    return retValue;
+}
+
+/**
+ * @brief @ref libqlp/qlp.h
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in,out] data parser file structure
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_evaluate_r(ST_QLP_CONTEXT *context, ST_QLP *data)
+{
+    int retValue;
+
+    LIBQLP_TRACE("context [%lu], data [%lu]", context, data);
+
     retValue = ERR_INVALID_ARGUMENT;
 
-    if (data)
+    if (context && data)
     {
-        retValue = LOG_evaluate(&data->log);
+        retValue = LOG_evaluate(&data->log, &context->pool);
     }
 
     LIBQLP_TRACE("retValue [%d]", retValue);
 
-    sem_post(&semaphore);
-
     return retValue;
 }
 
@@ -166,670 +107,737 @@ QLP_evaluate(ST_QLP *data)
  * @brief @ref libqlp/qlp.h
  *
  * @param[in] file file name
- * @param[out] data parser file structure
  * 
  * @return int ERR_xxx
  */
 extern int
-QLP_import(const char *file, ST_QLP *data)
+QLP_follow(const char *file)
 {
-    int retValue;
+    return QLP_follow_r(&defaultContext, file); /* Long-running: QLP semaphore is not held */
+}
 
-    LIBQLP_TRACE("*file [%s], data [%lu]", (file) ? file : "(null)", data);
+/**
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] file file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_follow_r(ST_QLP_CONTEXT *context, const char *file)
+{
+    int retValue;
 
-    sem_wait(&semaphore);
+    LIBQLP_TRACE("context [%lu], *file [%s]", context, (file) ? file : "(null)");
 
     retValue = ERR_INVALID_ARGUMENT;
 
-    if (data)
+    if (context)
     {
-        retValue = LOG_import(file, &data->log);
+        JSON_init(&context->json, context->compact, NULL, -1);
+
+        retValue = STREAM_follow(file, &context->json, &context->stop);
     }
 
     LIBQLP_TRACE("retValue [%d]", retValue);
 
-    sem_post(&semaphore);
-
     return retValue;
 }
 
 /**
  * @brief @ref libqlp/qlp.h
- * 
- * @param[in,out] data parser file structure
+ *
+ * @param[in] file file name
+ * @param[out] data parser file structure
  * 
  * @return int ERR_xxx
  */
 extern int
-QLP_report(ST_QLP *data)
+QLP_import(const char *file, ST_QLP *data)
 {
     int retValue;
 
-    LIBQLP_TRACE("data [%lu]", data);
-
-    sem_wait(&semaphore);
+    LIBQLP_TRACE("*file [%s], data [%lu]", (file) ? file : "(null)", data);
 
     retValue = ERR_INVALID_ARGUMENT;
 
     if (data)
     {
-        retValue = report(data);
+        retValue = LOG_import(file, &data->log);
     }
 
     LIBQLP_TRACE("retValue [%d]", retValue);
 
-    sem_post(&semaphore);
-
     return retValue;
 }
 
 /**
  * @brief @ref libqlp/qlp.h
+ *
+ * @param[out] context autodescriptive
  * 
  * @return int ERR_xxx
  */
 extern int
-QLP_start(void)
+QLP_newContext(ST_QLP_CONTEXT **context)
 {
-    static int start = -1;
+    int retValue;
 
-    if (!start)
+    LIBQLP_TRACE("context [%lu]", context);
+
+    if (!context)
     {
-        return ERR_ALREADY_STARTED;
+        return ERR_INVALID_ARGUMENT;
     }
 
-    if (UTILITIES_start())
+    *context = (ST_QLP_CONTEXT *) malloc(sizeof(ST_QLP_CONTEXT));
+
+    if (!*context)
     {
-        return ERR_DEFAULT;
+        return ERR_OUT_OF_MEMORY;
     }
 
-    if (LOG_start())
+    retValue = initContext(*context);
+
+    if (retValue)
     {
-        return ERR_DEFAULT;
+        free(*context); *context = NULL;
     }
 
-    sem_init(&semaphore, 0, 1);
+    LIBQLP_TRACE("retValue [%d]", retValue);
 
-    return ERR_NONE;
+    return retValue;
 }
 
 /**
  * @brief @ref libqlp/qlp.h
+ *
+ * @param[in] file file name
+ * @param[out] data parser file structure
  * 
- * @param[in,out] data ST_QLP variable
+ * @return int ERR_xxx
  */
-extern void
-QLP_free(ST_QLP *data)
+extern int
+QLP_parse(const char *file, ST_QLP *data)
 {
-    LIBQLP_TRACE("data [%lu]", data);
+    int retValue;
 
     sem_wait(&semaphore);
 
-    clearQLP(data, ERR_NONE);
-
-    LIBQLP_TRACE("(void)");
+    retValue = QLP_parse_r(&defaultContext, file, data);
 
     sem_post(&semaphore);
-}
 
-/*********************/
-/* Private functions */
-/*********************/
+    return retValue;
+}
 
 /**
- * @brief Appends a player to a player list.
- * 
- * @param list player list
- * @param name player name
- * @param lenght lenght of player name
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] file file name
+ * @param[out] data parser file structure
  * 
  * @return int ERR_xxx
  */
-static int
-appendPlayer(ST_PLAYER_REPORT **list, char *name, int lenght)
+extern int
+QLP_parse_r(ST_QLP_CONTEXT *context, const char *file, ST_QLP *data)
 {
-    ST_PLAYER_REPORT *pointer;
-
-    if (!list || !name || lenght <= 0)
-    {
-        return ERR_INVALID_ARGUMENT;
-    }
+    int retValue;
 
-    if (!strncmp(name, QLP_KEY_WORLD_PLAYER, lenght))
-    {
-        return ERR_INVALID_ARGUMENT;
-    }
+    LIBQLP_TRACE("context [%lu], *file [%s], data [%lu]", context, (file) ? file : "(null)", data);
 
-    pointer = *list;
+    retValue = ERR_INVALID_ARGUMENT;
 
-    while (pointer)
+    if (context && data)
     {
-        if (!strncmp(pointer->name, name, lenght))
-        {
-            return ERR_NONE; /* Player already on the list */
-        }
-
-        pointer = pointer->next;
+        retValue = LOG_parse(file, &data->log, &context->pool);
     }
 
-    pointer = (ST_PLAYER_REPORT *) malloc(sizeof(ST_PLAYER_REPORT));
-
-    UTILITIES_abort(!pointer);
-
-    pointer->next = *list;
-
-    pointer->killCount = 0;
+    LIBQLP_TRACE("retValue [%d]", retValue);
 
-    pointer->name = (char *) malloc(sizeof(char) * (lenght + 1));
+    return retValue;
+}
 
-    UTILITIES_abort(!pointer->name);
+/**
+ * @brief @ref libqlp/qlp.h
+ * 
+ * @param[in,out] data parser file structure
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_report(ST_QLP *data)
+{
+    int retValue;
 
-    strncpy(pointer->name, name, lenght);
+    sem_wait(&semaphore);
 
-    pointer->name[lenght] = 0;
+    retValue = QLP_report_r(&defaultContext, data);
 
-    *list = pointer;
+    sem_post(&semaphore);
 
-    return ERR_NONE;
+    return retValue;
 }
 
 /**
- * @brief @ref QLP_free()
+ * @brief @ref libqlp/qlp.h
  * 
- * @param data ST_QLP variable
- * @param error ERR_xxx
+ * @param[in,out] context autodescriptive
+ * @param[in] data parser file structure
  * 
  * @return int ERR_xxx
  */
-static int
-clearQLP(ST_QLP *data, int error)
+extern int
+QLP_report_r(ST_QLP_CONTEXT *context, ST_QLP *data)
 {
-    ST_KILL *kill[2];
-    ST_MATCH *match[2];
+    int retValue;
 
-    if (!data)
-    {
-        return error;
-    }
+    LIBQLP_TRACE("context [%lu], data [%lu]", context, data);
 
-    if (data->log.buffer)
-    {
-        free(data->log.buffer);
-    }
+    retValue = ERR_INVALID_ARGUMENT;
 
-    if (data->log.file)
+    if (context && data)
     {
-        free(data->log.file);
+        retValue = report(context, data, NULL, -1);
     }
 
-    if (data->log.match)
-    {
-        match[0] = data->log.match;
+    LIBQLP_TRACE("retValue [%d]", retValue);
 
-        while (match[0])
-        {
-            if (match[0]->kill)
-            {
-                kill[0] = match[0]->kill;
+    return retValue;
+}
+
+/**
+ * @brief @ref libqlp/qlp.h
+ * 
+ * @param[in] data parser file structure
+ * @param[in] fd output file descriptor
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportFd(ST_QLP *data, int fd)
+{
+    int retValue;
 
-                while (kill[0])
-                {
-                    if (kill[0]->buffer)
-                    {
-                        free(kill[0]->buffer);
-                    }
+    sem_wait(&semaphore);
 
-                    kill[1] = kill[0]->next;
+    retValue = QLP_reportFd_r(&defaultContext, data, fd);
 
-                    free(kill[0]);
+    sem_post(&semaphore);
 
-                    kill[0] = kill[1];
-                }
-            }
+    return retValue;
+}
 
-            if (match[0]->buffer)
-            {
-                free(match[0]->buffer);
-            }
+/**
+ * @brief @ref libqlp/qlp.h
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in] data parser file structure
+ * @param[in] fd output file descriptor
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportFd_r(ST_QLP_CONTEXT *context, ST_QLP *data, int fd)
+{
+    int retValue;
 
-            match[1] = match[0]->next;
+    LIBQLP_TRACE("context [%lu], data [%lu], fd [%d]", context, data, fd);
 
-            free(match[0]);
+    retValue = ERR_INVALID_ARGUMENT;
 
-            match[0] = match[1];
-        }
+    if (context && data && fd >= 0)
+    {
+        retValue = report(context, data, NULL, fd);
     }
 
-    memset(&data->log, 0, sizeof(ST_LOG));
+    LIBQLP_TRACE("retValue [%d]", retValue);
 
-    return error;
+    return retValue;
 }
 
 /**
- * @brief @ref Safely deallocates memory from the given input.
+ * @brief @ref libqlp/qlp.h
  * 
- * @param data ST_REPORT variable
- * @param error ERR_xxx
+ * @param[in] data parser file structure
+ * @param[in] file output stream
  * 
  * @return int ERR_xxx
  */
-static int
-clearReport(ST_REPORT *data, int error)
+extern int
+QLP_reportFile(ST_QLP *data, FILE *file)
 {
-    ST_PLAYER_REPORT *player[2];
-    int i;
-
-    if (!data->matchReport)
-    {
-        memset(data, 0, sizeof(ST_REPORT));
+    int retValue;
 
-        return error;
-    }
+    sem_wait(&semaphore);
 
-    for (i = 0; i < data->matchCount; i++)
-    {
-        if (data->matchReport[i].meanOfDeath)
-        {
-            free(data->matchReport[i].meanOfDeath);
-        }
+    retValue = QLP_reportFile_r(&defaultContext, data, file);
 
-        if (data->matchReport[i].player)
-        {
-            player[0] = data->matchReport[i].player;
+    sem_post(&semaphore);
 
-            while (player[0])
-            {
-                if (player[0]->name)
-                {
-                    free(player[0]->name);
-                }
+    return retValue;
+}
 
-                player[1] = player[0]->next;
+/**
+ * @brief @ref libqlp/qlp.h
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in] data parser file structure
+ * @param[in] file output stream
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportFile_r(ST_QLP_CONTEXT *context, ST_QLP *data, FILE *file)
+{
+    int retValue;
 
-                free(player[0]);
+    LIBQLP_TRACE("context [%lu], data [%lu], file [%lu]", context, data, file);
 
-                player[0] = player[1];
-            }
-        }
-    }
+    retValue = ERR_INVALID_ARGUMENT;
 
-    if (data->matchReport)
+    if (context && data && file)
     {
-        free(data->matchReport);
+        retValue = report(context, data, file, -1);
     }
 
-    return error;
+    LIBQLP_TRACE("retValue [%d]", retValue);
+
+    return retValue;
 }
 
 /**
- * @brief Creates a JSON stream from a ST_REPORT structure.
+ * @brief @ref libqlp/qlp.h
  * 
- * @param report ST_REPORT structure
- * @param json cJSON stream
+ * @param[in] data parser file structure
+ * @param[in] file output file name
  * 
  * @return int ERR_xxx
  */
-static int
-createJSON(ST_REPORT *report, cJSON **json)
+extern int
+QLP_reportPath(ST_QLP *data, const char *file)
 {
-    ST_PLAYER_REPORT *player;
-    cJSON *array;
-    cJSON *item[2];
-    cJSON *object[3];
-    char *stream;
-    char matchID[16];
-    int i, j;
-    int includeMeans;
+    int retValue;
 
-    if (!report || !json)
-    {
-        return ERR_INVALID_ARGUMENT;
-    }
+    sem_wait(&semaphore);
 
-    *json = cJSON_CreateObject();
+    retValue = QLP_reportPath_r(&defaultContext, data, file);
 
-    UTILITIES_abort(!*json);
+    sem_post(&semaphore);
 
-    for (i = 0; i < report->matchCount; i++)
-    {
-        object[0] = cJSON_CreateObject();
-
-        UTILITIES_abort(!object[0]);
-
-        item[0] = cJSON_CreateNumber((double) report->matchReport[i].killCount);
-
-        UTILITIES_abort(!item[0]);
-
-        cJSON_AddItemToObject(object[0], QLP_JSON_KEY_TOTAL_KILLS, item[0]);
+    return retValue;
+}
 
-        sprintf(matchID, QLP_JSON_KEY_GAME, i + 1);
+/**
+ * @brief @ref libqlp/qlp.h
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in] data parser file structure
+ * @param[in] file output file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_reportPath_r(ST_QLP_CONTEXT *context, ST_QLP *data, const char *file)
+{
+    int fd;
+    int retValue;
 
-        player = report->matchReport[i].player;
+    LIBQLP_TRACE("context [%lu], data [%lu], file [%s]", context, data, (file) ? file : "NULL");
 
-        array = cJSON_CreateArray();
+    retValue = ERR_INVALID_ARGUMENT;
 
-        UTILITIES_abort(!array);
+    if (context && data && data->log.match && file) /* Not evaluated: file untouched */
+    {
+        fd = open(file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
 
-        object[1] = cJSON_CreateObject();
-        
-        UTILITIES_abort(!object[1]);
+        retValue = (fd < 0) ? ERR_WRITE_FAILED : report(context, data, NULL, fd);
 
-        while (player)
+        if (fd >= 0 && close(fd) && !retValue)
         {
-            item[0] = cJSON_CreateString(player->name);
+            retValue = ERR_WRITE_FAILED;
+        }
+    }
 
-            UTILITIES_abort(!item[0]);
+    LIBQLP_TRACE("retValue [%d]", retValue);
 
-            cJSON_AddItemToArray(array, item[0]);
+    return retValue;
+}
 
-            item[1] = cJSON_CreateNumber(player->killCount);
+/**
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in] compact 1 for unformatted reports, 0 for indented reports
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_setCompact(int compact)
+{
+    int retValue;
 
-            UTILITIES_abort(!item[1]);
+    sem_wait(&semaphore);
 
-            cJSON_AddItemToObject(object[1], player->name, item[1]);
+    retValue = QLP_setCompact_r(&defaultContext, compact);
 
-            player = player->next;
-        }
+    sem_post(&semaphore);
 
-        includeMeans = 0;
+    return retValue;
+}
 
-        object[2] = cJSON_CreateObject();
+/**
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] compact 1 for unformatted reports, 0 for indented reports
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_setCompact_r(ST_QLP_CONTEXT *context, int compact)
+{
+    LIBQLP_TRACE("context [%lu], compact [%d]", context, compact);
 
-        for (j = (!object[2]) ? TOTAL_MEANS_OF_DEATH : 0; j < TOTAL_MEANS_OF_DEATH; j++)
-        {
-            if (!report->matchReport[i].meanOfDeath[j].killCount)
-            {
-                continue;
-            }
+    if (!context || (compact != 0 && compact != 1))
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
 
-            item[1] = cJSON_CreateNumber(report->matchReport[i].meanOfDeath[j].killCount);
+    context->compact = compact;
 
-            UTILITIES_abort(!item[1]);
+    return ERR_NONE;
+}
 
-            cJSON_AddItemToObject(object[2], report->matchReport[i].meanOfDeath[j].name, item[1]);
+/**
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in] jobs number of threads
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_setJobs(int jobs)
+{
+    int retValue;
 
-            includeMeans = 1;
-        }
+    sem_wait(&semaphore);
 
-        cJSON_AddItemToObject(object[0], QLP_JSON_KEY_PLAYERS, array);
+    retValue = QLP_setJobs_r(&defaultContext, jobs);
 
-        cJSON_AddItemToObject(object[0], QLP_JSON_KEY_KILLS, object[1]);
+    sem_post(&semaphore);
 
-        if (includeMeans)
-        {
-            cJSON_AddItemToObject(object[0], QLP_JSON_KEY_KILLS_BY_MEANS, object[2]);
-        }
+    return retValue;
+}
 
-        cJSON_AddItemToObject(*json, matchID, object[0]);
-    }
+/**
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] jobs number of threads
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_setJobs_r(ST_QLP_CONTEXT *context, int jobs)
+{
+    int retValue;
 
-    stream = cJSON_Print(*json);
+    LIBQLP_TRACE("context [%lu], jobs [%d]", context, jobs);
 
-    UTILITIES_abort(!stream);
+    retValue = ERR_INVALID_ARGUMENT;
 
-    LIBQLP_PRINTF("%s", stream);
+    if (context)
+    {
+        retValue = POOL_jobs(&context->pool, jobs);
+    }
 
-    free(stream);
+    LIBQLP_TRACE("retValue [%d]", retValue);
 
-    return ERR_NONE;
+    return retValue;
 }
 
 /**
- * @brief @ref QLP_report()
- * 
- * @param data parser file structure
+ * @brief @ref libqlp/qlp.h
  * 
  * @return int ERR_xxx
  */
-static int
-report(ST_QLP *data)
+extern int
+QLP_start(void)
 {
-    ST_KILL *kill;
-    ST_MATCH *match;
-    ST_REPORT report;
-    cJSON *json;
-    char *buffer;
-    int i;
-    int retValue;
-    unsigned long lenght;
+    static int start = -1;
 
-    if (!data)
+    if (!start)
     {
-        return ERR_INVALID_ARGUMENT;
+        return ERR_ALREADY_STARTED;
     }
 
-    if (!(data->log.match))
+    if (UTILITIES_start())
     {
-        return ERR_INVALID_ARGUMENT;
+        return ERR_DEFAULT;
     }
 
-    match = data->log.match;
-
-    memset(&report, 0, sizeof(ST_REPORT));
-
-    while (match)
+    if (LOG_start())
     {
-        report.matchCount += 1;
-
-        match = match->next;
+        return ERR_DEFAULT;
     }
 
-    report.matchReport = (ST_MATCH_REPORT *) malloc(sizeof(ST_MATCH_REPORT) * report.matchCount);
-
-    UTILITIES_abort(!report.matchReport);
-
-    memset(report.matchReport, 0, sizeof(ST_MATCH_REPORT) * report.matchCount);
-
-    for (i = 0; i < report.matchCount; i++)
+    if (NAME_start())
     {
-        report.matchReport[i].meanOfDeath = (ST_KILL_MEAN *) malloc(MEANS_OF_DEATH_LIST_SIZE);
-
-        UTILITIES_abort(!report.matchReport[i].meanOfDeath);
-
-        memcpy(report.matchReport[i].meanOfDeath, meansOfDeath, MEANS_OF_DEATH_LIST_SIZE);
+        return ERR_DEFAULT;
     }
 
-    json = NULL;
-
-    i = 0;
-
-    match = data->log.match;
-
-    while (match)
+    if (REPORT_start())
     {
-        buffer = match->buffer;
-
-        while (buffer)
-        {
-            buffer = strstr(buffer, QLP_KEY_PLAYER);
-
-            if (!buffer)
-            {
-                if (!report.matchReport[i].player) /* No players found */
-                {
-                    return clearReport(&report, ERR_INVALID_ARGUMENT);
-                }
-
-                break;
-            }
-
-            buffer = strstr(buffer, "n\\");
-
-            if (!buffer)
-            {
-                return clearReport(&report, ERR_INVALID_ARGUMENT);
-            }
-
-            buffer += 2; /* "n\" */
-
-            lenght = (unsigned long) strstr(buffer, "\\t");
-
-            if (!lenght)
-            {
-                return clearReport(&report, ERR_INVALID_ARGUMENT);
-            }
-
-            lenght -= (unsigned long) buffer;
-
-            appendPlayer(&(report.matchReport[i].player), buffer, (int) lenght);
-        }
-
-        kill = match->kill;
-
-        while (kill)
-        {
-            if (!kill->buffer)
-            {
-                return clearReport(&report, ERR_INVALID_ARGUMENT);
-            }
+        return ERR_DEFAULT;
+    }
 
-            buffer = kill->buffer;
+    if (SCAN_start())
+    {
+        return ERR_DEFAULT;
+    }
 
-            buffer = strstr(buffer + strlen(QLP_KEY_KILL), ":");
+    if (STREAM_start())
+    {
+        return ERR_DEFAULT;
+    }
 
-            if (!buffer)
-            {
-                return clearReport(&report, ERR_INVALID_ARGUMENT);
-            }
+    if (initContext(&defaultContext))
+    {
+        return ERR_DEFAULT;
+    }
 
-            buffer += 2; /* ": " */
+    sem_init(&semaphore, 0, 1);
 
-            lenght = (unsigned long) strstr(buffer, " killed");
+    return ERR_NONE;
+}
 
-            if (!lenght)
-            {
-                return clearReport(&report, ERR_INVALID_ARGUMENT);
-            }
+/**
+ * @brief @ref libqlp/qlp.h
+ */
+extern void
+QLP_stop(void)
+{
+    QLP_stop_r(&defaultContext);
+}
 
-            lenght -= (unsigned long) buffer;
+/**
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in,out] context autodescriptive
+ */
+extern void
+QLP_stop_r(ST_QLP_CONTEXT *context)
+{
+    if (context)
+    {
+        context->stop = 1; /* Async-signal-safe */
+    }
+}
 
-            if (strncmp(QLP_KEY_WORLD_PLAYER, buffer, lenght))
-            {
-                updatePlayer(report.matchReport[i].player, buffer, (int) lenght, 1);
+/**
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in] file file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_stream(const char *file)
+{
+    int retValue;
 
-                buffer = strstr(buffer, "by ");
+    sem_wait(&semaphore);
 
-                if (!buffer)
-                {
-                    return clearReport(&report, ERR_INVALID_ARGUMENT);
-                }
+    retValue = QLP_stream_r(&defaultContext, file);
 
-                buffer += 3; /* "by " */
+    sem_post(&semaphore);
 
-                updateMeanOfDeath(report.matchReport[i].meanOfDeath, buffer);
-            }
-            else
-            {
-                buffer = strstr(buffer, "killed ");
+    return retValue;
+}
 
-                if (!buffer)
-                {
-                    return clearReport(&report, ERR_INVALID_ARGUMENT);
-                }
+/**
+ * @brief @ref libqlp/qlp.h
+ *
+ * @param[in,out] context autodescriptive
+ * @param[in] file file name
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+QLP_stream_r(ST_QLP_CONTEXT *context, const char *file)
+{
+    int retValue;
 
-                buffer += strlen("killed ");
+    LIBQLP_TRACE("context [%lu], *file [%s]", context, (file) ? file : "(null)");
 
-                lenght = (unsigned long) strstr(buffer, " by");
+    retValue = ERR_INVALID_ARGUMENT;
 
-                if (!lenght)
-                {
-                    return clearReport(&report, ERR_INVALID_ARGUMENT);
-                }
+    if (context)
+    {
+        JSON_init(&context->json, context->compact, NULL, -1);
 
-                lenght -= (unsigned long) buffer;
+        retValue = STREAM_evaluate(file, &context->json);
+    }
 
-                updatePlayer(report.matchReport[i].player, buffer, (int) lenght, -1);
-            }
+    LIBQLP_TRACE("retValue [%d]", retValue);
 
-            report.matchReport[i].killCount += 1;
+    return retValue;
+}
 
-            kill = kill->next;
-        }
+/**
+ * @brief @ref libqlp/qlp.h
+ * 
+ * @param[in,out] data ST_QLP variable
+ */
+extern void
+QLP_free(ST_QLP *data)
+{
+    LIBQLP_TRACE("data [%lu]", data);
 
-        i += 1;
+    clearQLP(data, ERR_NONE);
 
-        match = match->next;
-    }
+    LIBQLP_TRACE("(void)");
+}
 
-    retValue = createJSON(&report, &json);
+/**
+ * @brief @ref libqlp/qlp.h
+ * 
+ * @param[in,out] context autodescriptive
+ */
+extern void
+QLP_freeContext(ST_QLP_CONTEXT *context)
+{
+    LIBQLP_TRACE("context [%lu]", context);
 
-    if (retValue)
+    if (!context || context == &defaultContext)
     {
-        return clearReport(&report, ERR_INVALID_ARGUMENT);
+        return;
     }
 
-    cJSON_Delete(json);
+    POOL_free(&context->pool);
 
-    return clearReport(&report, ERR_NONE);
+    free(context);
 }
 
+/*********************/
+/* Private functions */
+/*********************/
+
 /**
- * @brief Updates mean of death kill count.
+ * @brief @ref QLP_free()
  * 
- * @param list mean of death list
- * @param name mean of death name
+ * @param data ST_QLP variable
+ * @param error ERR_xxx
  * 
  * @return int ERR_xxx
  */
 static int
-updateMeanOfDeath(ST_KILL_MEAN *list, char *name)
+clearQLP(ST_QLP *data, int error)
 {
     int i;
 
-    if (!list || !name)
+    if (!data)
     {
-        return ERR_INVALID_ARGUMENT;
+        return error;
     }
 
-    for (i = 0; i < TOTAL_MEANS_OF_DEATH; i++)
+    if (data->log.buffer)
     {
-        if (!memcmp(list[i].name, name, strlen(list[i].name)))
+        if (data->log.mapped)
+        {
+            munmap(data->log.buffer, data->log.size + 1);
+        }
+        else
         {
-            list[i].killCount++;
+            free(data->log.buffer);
+        }
+    }
+
+    if (data->log.file)
+    {
+        free(data->log.file);
+    }
 
-            return ERR_NONE;
+    if (data->log.match)
+    {
+        for (i = 0; i < data->log.matchCount; i++)
+        {
+            MATCH_free(&data->log.match[i]);
         }
+
+        free(data->log.match);
     }
 
-    return ERR_INVALID_ARGUMENT;
+    ARENA_free(&data->log.arena);
+
+    memset(&data->log, 0, sizeof(ST_LOG));
+
+    return error;
+}
+
+/**
+ * @brief Initializes a context: no worker threads, indented reports.
+ * 
+ * @param data context structure
+ * 
+ * @return int ERR_xxx
+ */
+static int
+initContext(ST_QLP_CONTEXT *data)
+{
+    memset(data, 0, sizeof(ST_QLP_CONTEXT));
+
+    return POOL_init(&data->pool);
 }
 
 /**
- * @brief Updates the kill count of a player.
+ * @brief @ref QLP_report()
  * 
- * @param list player list
- * @param name player name
- * @param lenght lenght of player name
- * @param count value to be added to the player kill count
+ * @param context context structure
+ * @param data parser file structure
+ * @param file output stream (standard output, if NULL and fd < 0)
+ * @param fd output file descriptor (none, if < 0)
  * 
  * @return int ERR_xxx
  */
 static int
-updatePlayer(ST_PLAYER_REPORT *list, char *name, int lenght, int count)
+report(ST_QLP_CONTEXT *context, ST_QLP *data, FILE *file, int fd)
 {
-    if (!list || !name || lenght <= 0)
+    int error;
+    int i;
+    int retValue;
+
+    if (!data)
     {
         return ERR_INVALID_ARGUMENT;
     }
 
-    if (!strncmp(name, QLP_KEY_WORLD_PLAYER, lenght))
+    if (!(data->log.match))
     {
         return ERR_INVALID_ARGUMENT;
     }
 
-    while (list)
+    JSON_init(&context->json, context->compact, file, fd);
+
+    retValue = ERR_NONE;
+
+    for (i = 0; i < data->log.matchCount; i++)
     {
-        if (strncmp(list->name, name, lenght))
-        {
-            list = list->next;
+        error = REPORT_print(data->log.match[i].report, i + 1, &context->json);
 
-            continue;
-        }
+        retValue = (retValue) ? retValue : error;
+    }
+
+    error = REPORT_close(data->log.matchCount, &context->json);
 
-        list->killCount += count; /* Player found */
+    retValue = (retValue) ? retValue : error;
 
-        return ERR_NONE;
+    if (!retValue && fd < 0 && file && fflush(file))
+    {
+        retValue = ERR_WRITE_FAILED;
     }
 
-    return ERR_INVALID_ARGUMENT;
+    return retValue;
 }
@@ -11,9 +11,18 @@
 
 #include "libqlp/qlp.h" /* Public entry point */
 
-#include "kill.h"
+#include "arena.h"
+#include "event.h"
+#include "json.h"
 #include "log.h"
 #include "match.h"
+#include "name.h"
+#include "pool.h"
+#include "queue.h"
+#include "report.h"
+#include "scan.h"
+#include "source.h"
+#include "stream.h"
 #include "utilities.h"
 
 /**********/
@@ -22,8 +31,10 @@
 
 #ifdef _UNIT_TESTS_
 #define LIBQLP_PRINTF(...) /* NULL */
+#define LIBQLP_WRITE(buffer, size) /* NULL */
 #else
 #define LIBQLP_PRINTF(...) printf(__VA_ARGS__)
+#define LIBQLP_WRITE(buffer, size) fwrite((buffer), 1, (size), stdout)
 #endif /* _UNIT_TESTS_ */
 
 #ifdef _DEBUG_
@@ -32,6 +43,8 @@
 #define LIBQLP_TRACE(...) /* NULL */
 #endif /* #ifdef _DEBUG_ */
 
+#define QLP_FILE_STDIN "-"
+#define QLP_FOLLOW_TIMEOUT 1000 /* ms */
 #define QLP_JSON_KEY_GAME "game_%d"
 #define QLP_JSON_KEY_KILLS "kills"
 #define QLP_JSON_KEY_KILLS_BY_MEANS "kills_by_means"
@@ -40,6 +53,9 @@
 #define QLP_KEY_KILL "Kill:"
 #define QLP_KEY_MATCH "InitGame:"
 #define QLP_KEY_PLAYER "ClientUserinfoChanged:"
+#define QLP_KEY_SHUTDOWN "ShutdownGame:"
 #define QLP_KEY_WORLD_PLAYER "<world>"
+#define QLP_STREAM_BUFFER_SIZE (64 * 1024)
+#define QLP_WORLD_ID 1022 /* Client slot of QLP_KEY_WORLD_PLAYER */
 
 #endif /* #ifndef _QLP_H_INCLUDED_ */
@@ -0,0 +1,187 @@
+/**
+ * @file queue.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief QUEUE API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "queue.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static void
+park(int *parked, sem_t *semaphore, unsigned int *index, unsigned int stale);
+
+static void
+wake(int *parked, sem_t *semaphore);
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref queue.h
+ *
+ * @param[in,out] data queue structure
+ */
+extern void
+QUEUE_free(ST_QUEUE *data)
+{
+    if (!data)
+    {
+        return;
+    }
+
+    sem_destroy(&data->free);
+
+    sem_destroy(&data->used);
+
+    memset(data, 0, sizeof(ST_QUEUE));
+}
+
+/**
+ * @brief @ref queue.h
+ *
+ * @param[out] data queue structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+QUEUE_init(ST_QUEUE *data)
+{
+    if (!data)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    memset(data, 0, sizeof(ST_QUEUE));
+
+    sem_init(&data->free, 0, 0);
+
+    sem_init(&data->used, 0, 0);
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref queue.h
+ *
+ * @param[in,out] data queue structure
+ *
+ * @return int autodescriptive
+ */
+extern int
+QUEUE_pending(ST_QUEUE *data)
+{
+    unsigned int head;
+    unsigned int tail;
+
+    tail = __atomic_load_n(&data->tail, __ATOMIC_ACQUIRE);
+
+    head = __atomic_load_n(&data->head, __ATOMIC_ACQUIRE);
+
+    return (int) (tail - head);
+}
+
+/**
+ * @brief @ref queue.h
+ *
+ * @param[in,out] data queue structure
+ *
+ * @return void * autodescriptive
+ */
+extern void *
+QUEUE_pop(ST_QUEUE *data)
+{
+    void *item;
+    unsigned int head;
+
+    head = __atomic_load_n(&data->head, __ATOMIC_RELAXED);
+
+    park(&data->consumer, &data->used, &data->tail, head); /* While empty */
+
+    item = data->item[head % QUEUE_SIZE];
+
+    __atomic_store_n(&data->head, head + 1, __ATOMIC_RELEASE);
+
+    wake(&data->producer, &data->free);
+
+    return item;
+}
+
+/**
+ * @brief @ref queue.h
+ *
+ * @param[in,out] data queue structure
+ * @param[in] item autodescriptive (NULL included)
+ */
+extern void
+QUEUE_push(ST_QUEUE *data, void *item)
+{
+    unsigned int tail;
+
+    tail = __atomic_load_n(&data->tail, __ATOMIC_RELAXED);
+
+    park(&data->producer, &data->free, &data->head, tail - QUEUE_SIZE); /* While full */
+
+    data->item[tail % QUEUE_SIZE] = item;
+
+    __atomic_store_n(&data->tail, tail + 1, __ATOMIC_RELEASE);
+
+    wake(&data->consumer, &data->used);
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Waits until the other side moves its index off a stale value. The
+ * caller raises its parked flag before sleeping and checks the index once
+ * more, so a wake() racing with it is never lost. Both sides swap the flag
+ * (acq_rel): either wake() reads it raised, or it cleared the flag first and
+ * the swap here syncs with it, so the new index is seen.
+ *
+ * @param parked parked flag of the caller
+ * @param semaphore semaphore the caller sleeps on
+ * @param index index of the other side
+ * @param stale value of index that keeps the caller waiting
+ */
+static void
+park(int *parked, sem_t *semaphore, unsigned int *index, unsigned int stale)
+{
+    while (__atomic_load_n(index, __ATOMIC_ACQUIRE) == stale)
+    {
+        __atomic_exchange_n(parked, 1, __ATOMIC_ACQ_REL);
+
+        if (__atomic_load_n(index, __ATOMIC_ACQUIRE) != stale && __atomic_exchange_n(parked, 0, __ATOMIC_ACQ_REL))
+        {
+            break; /* Moved before anyone saw the flag */
+        }
+
+        while (sem_wait(semaphore)); /* Woken, or takes the wake up racing with the check */
+    }
+}
+
+/**
+ * @brief Wakes the other side up if it is parked, once the caller has
+ * published its index.
+ *
+ * @param parked parked flag of the other side
+ * @param semaphore semaphore the other side sleeps on
+ */
+static void
+wake(int *parked, sem_t *semaphore)
+{
+    if (__atomic_exchange_n(parked, 0, __ATOMIC_ACQ_REL))
+    {
+        sem_post(semaphore);
+    }
+}
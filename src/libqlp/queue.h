@@ -0,0 +1,96 @@
+/**
+ * @file queue.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _QUEUE_H_INCLUDED_
+#define _QUEUE_H_INCLUDED_
+
+#include "qlp.h"
+
+#include <semaphore.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#define QUEUE_SIZE 64
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef struct QUEUE
+{
+    unsigned int head; /* Next item popped (written by the consumer only) */
+    unsigned int tail; /* Next item pushed (written by the producer only) */
+    int consumer; /* Consumer parked (on used) */
+    int producer; /* Producer parked (on free) */
+    sem_t free; /* Wakes the producer up */
+    sem_t used; /* Wakes the consumer up */
+    void *item[QUEUE_SIZE];
+} ST_QUEUE;
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Releases a queue. Pending items are dropped.
+ *
+ * @param[in,out] data queue structure
+ */
+extern void
+QUEUE_free(ST_QUEUE *data);
+
+/**
+ * @brief Initializes an empty queue. A queue is a bounded ring connecting a
+ * single producer to a single consumer: each index is only written by its
+ * side and published with release/acquire atomics, so no lock is taken. A
+ * side only sleeps (on a semaphore) when it gets QUEUE_SIZE items ahead of
+ * (or runs dry behind) the other one, which then wakes it up.
+ *
+ * @param[out] data queue structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+QUEUE_init(ST_QUEUE *data);
+
+/**
+ * @brief Number of items pushed but not popped yet (an estimate, if read
+ * while the other side runs).
+ *
+ * @param[in,out] data queue structure
+ *
+ * @return int autodescriptive
+ */
+extern int
+QUEUE_pending(ST_QUEUE *data);
+
+/**
+ * @brief Takes the oldest item of a queue, waiting for one if it is empty.
+ * Consumer only.
+ *
+ * @param[in,out] data queue structure
+ *
+ * @return void * autodescriptive
+ */
+extern void *
+QUEUE_pop(ST_QUEUE *data);
+
+/**
+ * @brief Appends an item to a queue, waiting for room if it is full.
+ * Producer only.
+ *
+ * @param[in,out] data queue structure
+ * @param[in] item autodescriptive (NULL included)
+ */
+extern void
+QUEUE_push(ST_QUEUE *data, void *item);
+
+#endif /* #ifndef _QUEUE_H_INCLUDED_ */
@@ -0,0 +1,752 @@
+/**
+ * @file report.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief REPORT API.
+ * @date 2026-10-17
+ * 
+ */
+
+#include "report.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#define PLAYER_HASH(id) ((unsigned int) (id) * 2654435761u) /* Spreads dense IDs */
+
+#define PLAYER_TABLE_SIZE 16 /* Initial */
+
+#ifdef _VALIDATE_MOD_
+#define VALIDATE_MOD 1 /* Check MOD names against MOD IDs */
+#else
+#define VALIDATE_MOD 0
+#endif /* #ifdef _VALIDATE_MOD_ */
+
+#define MEANS_OF_DEATH_LIST_SIZE \
+( \
+    (int) (sizeof(ST_KILL_MEAN) * TOTAL_MEANS_OF_DEATH) \
+)
+
+#define TOTAL_MEANS_OF_DEATH \
+( \
+    (int) (sizeof(meansOfDeath) / sizeof(ST_KILL_MEAN)) \
+)
+
+/**************/
+/* Constantes */
+/**************/
+
+static const ST_KILL_MEAN meansOfDeath[] = /* Indexed by MOD ID */
+{
+    { "MOD_UNKNOWN", 0 },
+    { "MOD_SHOTGUN", 0 },
+    { "MOD_GAUNTLET", 0 },
+    { "MOD_MACHINEGUN", 0 },
+    { "MOD_GRENADE", 0 },
+    { "MOD_GRENADE_SPLASH", 0 },
+    { "MOD_ROCKET", 0 },
+    { "MOD_ROCKET_SPLASH", 0 },
+    { "MOD_PLASMA", 0 },
+    { "MOD_PLASMA_SPLASH", 0 },
+    { "MOD_RAILGUN", 0 },
+    { "MOD_LIGHTNING", 0 },
+    { "MOD_BFG", 0 },
+    { "MOD_BFG_SPLASH", 0 },
+    { "MOD_WATER", 0 },
+    { "MOD_SLIME", 0 },
+    { "MOD_LAVA", 0 },
+    { "MOD_CRUSH", 0 },
+    { "MOD_TELEFRAG", 0 },
+    { "MOD_FALLING", 0 },
+    { "MOD_SUICIDE", 0 },
+    { "MOD_TARGET_LASER", 0 },
+    { "MOD_TRIGGER_HURT", 0 },
+    { "MOD_NAIL", 0 },
+    { "MOD_CHAINGUN", 0 },
+    { "MOD_PROXIMITY_MINE", 0 },
+    { "MOD_KAMIKAZE", 0 },
+    { "MOD_JUICED", 0 },
+    { "MOD_GRAPPLE", 0 }
+};
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static int
+appendPlayer(ST_MATCH_REPORT *data, const char *name, int lenght, ST_PLAYER_REPORT **player);
+
+static int
+evaluateKill(ST_MATCH_REPORT *data, const char *stream, const ST_EVENT *event);
+
+static int
+evaluatePlayer(ST_MATCH_REPORT *data, const char *stream, const ST_EVENT *event);
+
+static ST_PLAYER_REPORT **
+findPlayer(ST_MATCH_REPORT *data, int id);
+
+static int
+isPlayer(const ST_PLAYER_REPORT *player, const char *name, int lenght);
+
+static int
+isWorld(const char *name, int lenght);
+
+static int
+prepare(ST_MATCH_REPORT *data);
+
+static int
+resizePlayers(ST_MATCH_REPORT *data);
+
+static int
+updateMeanOfDeath(ST_KILL_MEAN *list, int id, const char *name, int lenght);
+
+static int
+updatePlayer(ST_MATCH_REPORT *data, int id, const char *name, int lenght, int count);
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref report.h
+ *
+ * @param[in] matchCount number of printed matches
+ * @param[in,out] json report stream
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_close(int matchCount, ST_JSON *json)
+{
+    int retValue;
+
+    LIBQLP_TRACE("matchCount [%d], json [%lu]", matchCount, json);
+
+    if (matchCount <= 0 || !json)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    JSON_close(json);
+
+    retValue = JSON_flush(json);
+
+    LIBQLP_TRACE("retValue [%d]", retValue);
+
+    return retValue;
+}
+
+/**
+ * @brief @ref report.h
+ *
+ * @param[in,out] data match report structure
+ * @param[in] stream event key (origin of its fields)
+ * @param[in] event event structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_event(ST_MATCH_REPORT *data, const char *stream, const ST_EVENT *event)
+{
+    int retValue;
+
+    if (!data || !stream || !event)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    switch (event->type)
+    {
+    case EVENT_KILL:
+        retValue = evaluateKill(data, stream, event);
+        break;
+
+    case EVENT_PLAYER:
+        retValue = evaluatePlayer(data, stream, event);
+        break;
+
+    default:
+        retValue = ERR_INVALID_ARGUMENT; /* Malformed line */
+        break;
+    }
+
+    return retValue;
+}
+
+/**
+ * @brief @ref report.h
+ *
+ * @param[in,out] data match report structure
+ */
+extern void
+REPORT_free(ST_MATCH_REPORT *data)
+{
+    LIBQLP_TRACE("data [%lu]", data);
+
+    if (!data)
+    {
+        return;
+    }
+
+    ARENA_free(&data->arena); /* No list walk */
+
+    memset(data, 0, sizeof(ST_MATCH_REPORT));
+}
+
+/**
+ * @brief @ref report.h
+ *
+ * @param[out] data match report structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_init(ST_MATCH_REPORT *data)
+{
+    LIBQLP_TRACE("data [%lu]", data);
+
+    if (!data)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    memset(data, 0, sizeof(ST_MATCH_REPORT));
+
+    return prepare(data);
+}
+
+/**
+ * @brief @ref report.h
+ *
+ * @param[in] data match report structure
+ * @param[in] id match number (1 opens the stream)
+ * @param[in,out] json report stream
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_print(ST_MATCH_REPORT *data, int id, ST_JSON *json)
+{
+    ST_PLAYER_REPORT *player;
+    char matchID[16];
+    int j;
+    int retValue;
+    int separator;
+
+    LIBQLP_TRACE("data [%lu], id [%d], json [%lu]", data, id, json);
+
+    if (!data || id <= 0 || !json)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (id == 1)
+    {
+        JSON_open(json, '{');
+    }
+
+    sprintf(matchID, QLP_JSON_KEY_GAME, id);
+
+    JSON_key(json, matchID);
+
+    JSON_open(json, '{');
+
+    JSON_key(json, QLP_JSON_KEY_TOTAL_KILLS);
+
+    JSON_number(json, data->killCount);
+
+    JSON_key(json, QLP_JSON_KEY_PLAYERS);
+
+    JSON_open(json, '[');
+
+    for (player = data->player; player; player = player->next)
+    {
+        JSON_string(json, player->name);
+    }
+
+    JSON_close(json);
+
+    JSON_key(json, QLP_JSON_KEY_KILLS);
+
+    JSON_open(json, '{');
+
+    for (player = data->player; player; player = player->next)
+    {
+        JSON_key(json, player->name);
+
+        JSON_number(json, player->killCount);
+    }
+
+    JSON_close(json);
+
+    separator = 0;
+
+    for (j = 0; j < TOTAL_MEANS_OF_DEATH; j++)
+    {
+        if (!data->meanOfDeath[j].killCount)
+        {
+            continue;
+        }
+
+        if (!separator)
+        {
+            JSON_key(json, QLP_JSON_KEY_KILLS_BY_MEANS); /* Only if any kill by means */
+
+            JSON_open(json, '{');
+        }
+
+        separator = 1;
+
+        JSON_key(json, data->meanOfDeath[j].name);
+
+        JSON_number(json, data->meanOfDeath[j].killCount);
+    }
+
+    if (separator)
+    {
+        JSON_close(json);
+    }
+
+    JSON_close(json);
+
+    retValue = (json->error) ? ERR_WRITE_FAILED : ERR_NONE; /* Sticky, see JSON_flush() */
+
+    LIBQLP_TRACE("retValue [%d]", retValue);
+
+    return retValue;
+}
+
+/**
+ * @brief @ref report.h
+ *
+ * @param[in,out] data match report structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_reset(ST_MATCH_REPORT *data)
+{
+    ST_ARENA arena;
+
+    LIBQLP_TRACE("data [%lu]", data);
+
+    if (!data)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    arena = data->arena;
+
+    ARENA_reset(&arena);
+
+    memset(data, 0, sizeof(ST_MATCH_REPORT));
+
+    data->arena = arena;
+
+    return prepare(data);
+}
+
+/**
+ * @brief @ref report.h
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_start(void)
+{
+    static int start = -1;
+
+    if (!start)
+    {
+        return ERR_ALREADY_STARTED;
+    }
+
+    return ERR_NONE;
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Appends a player to a match report, unless it is already there or
+ * it is QLP_KEY_WORLD_PLAYER. The name is interned once, and the player is
+ * then looked up by name ID (names are never compared here).
+ * 
+ * @param data match report structure
+ * @param name player name
+ * @param lenght lenght of player name
+ * @param player new or existing entry
+ * 
+ * @return int ERR_xxx
+ */
+static int
+appendPlayer(ST_MATCH_REPORT *data, const char *name, int lenght, ST_PLAYER_REPORT **player)
+{
+    ST_PLAYER_REPORT **slot;
+    ST_PLAYER_REPORT *pointer;
+    const char *string;
+    int id;
+
+    if (!data || !name || lenght <= 0)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (isWorld(name, lenght))
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    UTILITIES_abort(NAME_intern(name, lenght, &id, &string) != ERR_NONE);
+
+    slot = findPlayer(data, id);
+
+    if (*slot)
+    {
+        *player = *slot;
+
+        return ERR_NONE; /* Player already on the list */
+    }
+
+    pointer = (ST_PLAYER_REPORT *) ARENA_alloc(&data->arena, sizeof(ST_PLAYER_REPORT));
+
+    UTILITIES_abort(!pointer);
+
+    pointer->next = data->player;
+
+    pointer->killCount = 0;
+
+    pointer->id = id;
+
+    pointer->name = string;
+
+    pointer->lenght = lenght;
+
+    data->player = pointer;
+
+    *slot = pointer;
+
+    data->playerCount += 1;
+
+    *player = pointer;
+
+    if (data->playerCount * 2 > data->tableSize)
+    {
+        UTILITIES_abort(resizePlayers(data) != ERR_NONE);
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Aggregates an EVENT_KILL: a kill is credited to its killer (and
+ * counted by its mean of death), unless the killer is the world
+ * (QLP_WORLD_ID), in which case it is taken from its victim. Players are
+ * resolved by client slot. With VALIDATE_MOD, a kill whose MOD name does
+ * not match its MOD ID is rejected.
+ * 
+ * @param data match report structure
+ * @param stream event key
+ * @param event event structure
+ * 
+ * @return int ERR_xxx
+ */
+static int
+evaluateKill(ST_MATCH_REPORT *data, const char *stream, const ST_EVENT *event)
+{
+    const ST_FIELD *field;
+    int retValue;
+
+    if (event->id[FIELD_KILLER] != QLP_WORLD_ID)
+    {
+        field = &event->field[FIELD_KILLER];
+
+        updatePlayer(data, event->id[FIELD_KILLER], stream + field->offset, (int) field->size, 1);
+
+        field = &event->field[FIELD_MEAN_OF_DEATH];
+
+        retValue = updateMeanOfDeath(data->meanOfDeath, event->id[FIELD_MEAN_OF_DEATH], stream + field->offset, (int) field->size);
+
+        if (retValue && VALIDATE_MOD)
+        {
+            return retValue;
+        }
+    }
+    else
+    {
+        field = &event->field[FIELD_VICTIM];
+
+        updatePlayer(data, event->id[FIELD_VICTIM], stream + field->offset, (int) field->size, -1);
+    }
+
+    data->killCount += 1;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Aggregates an EVENT_PLAYER: the player is appended, if new, and
+ * becomes the current player of its client slot (a rename moves the slot
+ * to the new name). The name is only interned when the slot changes hands,
+ * so the NAME API is called a handful of times per match, not per event.
+ * 
+ * @param data match report structure
+ * @param stream event key
+ * @param event event structure
+ * 
+ * @return int ERR_xxx
+ */
+static int
+evaluatePlayer(ST_MATCH_REPORT *data, const char *stream, const ST_EVENT *event)
+{
+    ST_PLAYER_REPORT *player;
+    const ST_FIELD *field;
+    int id;
+
+    field = &event->field[FIELD_PLAYER];
+
+    id = event->id[FIELD_PLAYER];
+
+    if (id >= 0 && id < REPORT_CLIENT_SLOTS && isPlayer(data->slot[id], stream + field->offset, (int) field->size))
+    {
+        return ERR_NONE; /* Same player, same name */
+    }
+
+    if (appendPlayer(data, stream + field->offset, (int) field->size, &player))
+    {
+        return ERR_NONE;
+    }
+
+    if (id >= 0 && id < REPORT_CLIENT_SLOTS)
+    {
+        data->slot[id] = player;
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Looks a player up by its name ID (linear probing).
+ * 
+ * @param data match report structure
+ * @param id name ID
+ * 
+ * @return ST_PLAYER_REPORT ** slot holding the player, or the empty slot it
+ * would take
+ */
+static ST_PLAYER_REPORT **
+findPlayer(ST_MATCH_REPORT *data, int id)
+{
+    ST_PLAYER_REPORT *pointer;
+    unsigned int i;
+    unsigned int mask;
+
+    mask = (unsigned int) data->tableSize - 1;
+
+    for (i = PLAYER_HASH(id) & mask; ; i = (i + 1) & mask)
+    {
+        pointer = data->table[i];
+
+        if (!pointer || pointer->id == id)
+        {
+            break;
+        }
+    }
+
+    return &data->table[i];
+}
+
+/**
+ * @brief Checks whether a player goes by a name.
+ * 
+ * @param player match player (may be NULL)
+ * @param name player name
+ * @param lenght lenght of player name
+ * 
+ * @return int 1 if so, 0 otherwise
+ */
+static int
+isPlayer(const ST_PLAYER_REPORT *player, const char *name, int lenght)
+{
+    return player && player->lenght == lenght && !memcmp(player->name, name, lenght);
+}
+
+/**
+ * @brief Checks whether a name is QLP_KEY_WORLD_PLAYER.
+ * 
+ * @param name player name
+ * @param lenght lenght of player name
+ * 
+ * @return int 1 if so, 0 otherwise
+ */
+static int
+isWorld(const char *name, int lenght)
+{
+    return lenght == (int) strlen(QLP_KEY_WORLD_PLAYER) && !memcmp(name, QLP_KEY_WORLD_PLAYER, lenght);
+}
+
+/**
+ * @brief Allocates the lists of an empty match report from its arena.
+ * 
+ * @param data match report structure (zeroed, but for its arena)
+ * 
+ * @return int ERR_xxx
+ */
+static int
+prepare(ST_MATCH_REPORT *data)
+{
+    data->meanOfDeath = (ST_KILL_MEAN *) ARENA_alloc(&data->arena, MEANS_OF_DEATH_LIST_SIZE);
+
+    if (!data->meanOfDeath)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    memcpy(data->meanOfDeath, meansOfDeath, MEANS_OF_DEATH_LIST_SIZE);
+
+    data->table = (ST_PLAYER_REPORT **) ARENA_alloc(&data->arena, PLAYER_TABLE_SIZE * sizeof(ST_PLAYER_REPORT *));
+
+    if (!data->table)
+    {
+        ARENA_free(&data->arena); data->meanOfDeath = NULL;
+
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    memset(data->table, 0, PLAYER_TABLE_SIZE * sizeof(ST_PLAYER_REPORT *));
+
+    data->tableSize = PLAYER_TABLE_SIZE;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Doubles the player table of a match report.
+ * 
+ * @param data match report structure
+ * 
+ * @return int ERR_xxx
+ */
+static int
+resizePlayers(ST_MATCH_REPORT *data)
+{
+    ST_PLAYER_REPORT **table;
+    ST_PLAYER_REPORT *pointer;
+    unsigned int i;
+    unsigned int mask;
+
+    table = (ST_PLAYER_REPORT **) ARENA_alloc(&data->arena, data->tableSize * 2 * sizeof(ST_PLAYER_REPORT *));
+
+    if (!table)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    memset(table, 0, data->tableSize * 2 * sizeof(ST_PLAYER_REPORT *));
+
+    mask = (unsigned int) data->tableSize * 2 - 1;
+
+    for (pointer = data->player; pointer; pointer = pointer->next)
+    {
+        for (i = PLAYER_HASH(pointer->id) & mask; table[i]; i = (i + 1) & mask);
+
+        table[i] = pointer;
+    }
+
+    data->table = table; /* The old one is left to the arena */
+
+    data->tableSize *= 2;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Updates mean of death kill count. The MOD ID of the kill line
+ * indexes the list directly; its name is only compared with VALIDATE_MOD.
+ * 
+ * @param list mean of death list
+ * @param id MOD ID
+ * @param name mean of death name
+ * @param lenght lenght of name
+ * 
+ * @return int ERR_xxx
+ */
+static int
+updateMeanOfDeath(ST_KILL_MEAN *list, int id, const char *name, int lenght)
+{
+    if (!list || id < 0 || id >= TOTAL_MEANS_OF_DEATH)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (VALIDATE_MOD && (lenght != (int) strlen(list[id].name) || memcmp(list[id].name, name, lenght)))
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    list[id].killCount++;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Updates the kill count of a player, found by client slot. A slot
+ * seen for the first time (no ClientUserinfoChanged line yet) takes the
+ * name of the kill line, and the player is appended if new, so the kill is
+ * not lost.
+ * 
+ * @param data match report structure
+ * @param id client slot
+ * @param name player name
+ * @param lenght lenght of player name
+ * @param count value to be added to the player kill count
+ * 
+ * @return int ERR_xxx
+ */
+static int
+updatePlayer(ST_MATCH_REPORT *data, int id, const char *name, int lenght, int count)
+{
+    ST_PLAYER_REPORT *player;
+
+    if (!data)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (id >= 0 && id < REPORT_CLIENT_SLOTS && data->slot[id])
+    {
+        data->slot[id]->killCount += count;
+
+        return ERR_NONE;
+    }
+
+    if (!name || lenght <= 0)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (isWorld(name, lenght))
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (appendPlayer(data, name, lenght, &player))
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (id >= 0 && id < REPORT_CLIENT_SLOTS)
+    {
+        data->slot[id] = player;
+    }
+
+    player->killCount += count;
+
+    return ERR_NONE;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file report.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _REPORT_H_INCLUDED_
+#define _REPORT_H_INCLUDED_
+
+#include "qlp.h"
+
+/**********/
+/* Macros */
+/**********/
+
+#define REPORT_CLIENT_SLOTS 64 /* MAX_CLIENTS */
+
+/********************/
+/* Type definitions */
+/********************/
+
+struct EVENT; /* event.h */
+
+struct JSON; /* json.h */
+
+typedef struct KILL_MEAN
+{
+    char name[32];
+    int killCount;
+} ST_KILL_MEAN;
+
+typedef struct PLAYER_REPORT
+{
+    const char *name; /* Interned (NAME_intern()), shared by every match */
+    int id; /* Name ID: players are looked up and compared by it */
+    int killCount;
+    int lenght; /* Of name */
+    struct PLAYER_REPORT *next;
+} ST_PLAYER_REPORT;
+
+typedef struct MATCH_REPORT
+{
+    ST_ARENA arena; /* Everything below, released at once */
+    ST_KILL_MEAN *meanOfDeath;
+    ST_PLAYER_REPORT *player; /* Report order (most recent first) */
+    ST_PLAYER_REPORT **table; /* Open addressing, by name ID */
+    ST_PLAYER_REPORT *slot[REPORT_CLIENT_SLOTS]; /* Current player of each client slot */
+    int killCount;
+    int playerCount;
+    int tableSize; /* Power of 2, kept at most half full */
+} ST_MATCH_REPORT;
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Closes a JSON report stream previously fed by REPORT_print(), and
+ * flushes it.
+ *
+ * @param[in] matchCount number of printed matches
+ * @param[in,out] json report stream
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_close(int matchCount, struct JSON *json);
+
+/**
+ * @brief Aggregates an event (EVENT_KILL or EVENT_PLAYER) into a match
+ * report. Events must be fed in log order, as players are tracked by client
+ * slot. Only the given report is touched, so distinct reports can be fed
+ * from distinct threads.
+ *
+ * @param[in,out] data match report structure
+ * @param[in] stream event key (origin of its fields)
+ * @param[in] event event structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_event(ST_MATCH_REPORT *data, const char *stream, const struct EVENT *event);
+
+/**
+ * @brief Safely deallocates memory from the given input.
+ *
+ * @param[in,out] data match report structure
+ */
+extern void
+REPORT_free(ST_MATCH_REPORT *data);
+
+/**
+ * @brief Initializes an empty match report.
+ *
+ * @param[out] data match report structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_init(ST_MATCH_REPORT *data);
+
+/**
+ * @brief Prints a match report as the next member of a JSON report stream.
+ * The stream is only written when its buffer fills up (and by
+ * REPORT_close()); callers wanting each match out at once JSON_flush() it.
+ * The stream (its layout and output) is set up by the caller (JSON_init())
+ * before the first match; distinct streams share nothing.
+ *
+ * @param[in] data match report structure
+ * @param[in] id match number (1 opens the stream)
+ * @param[in,out] json report stream
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_print(ST_MATCH_REPORT *data, int id, struct JSON *json);
+
+/**
+ * @brief Empties a match report for reuse, as REPORT_init() would, but its
+ * arena keeps its largest block (see ARENA_reset()). The report must be
+ * initialized or zeroed.
+ *
+ * @param[in,out] data match report structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_reset(ST_MATCH_REPORT *data);
+
+/**
+ * @brief Initializes the REPORT API.
+ *
+ * @return int ERR_xxx
+ */
+extern int
+REPORT_start(void);
+
+#endif /* #ifndef _REPORT_H_INCLUDED_ */
@@ -0,0 +1,414 @@
+/**
+ * @file scan.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief SCAN API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "scan.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86
+#include <immintrin.h>
+#endif /* #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) */
+
+/**********/
+/* Macros */
+/**********/
+
+#define SCAN_KEY_COUNT 4
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef struct SCAN_ENTRY
+{
+    const char *name;
+    unsigned long lenght;
+    int key; /* SCAN_xxx */
+} ST_SCAN_ENTRY;
+
+typedef const char *(*PF_SCAN)(const ST_SCAN_ENTRY *, int, int, const char *, const char *, int *);
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+#ifdef SCAN_X86
+static const char *
+findAVX2(const ST_SCAN_ENTRY *entry, int count, int mask, const char *stream, const char *limit, int *key);
+
+static const char *
+findSSE2(const ST_SCAN_ENTRY *entry, int count, int mask, const char *stream, const char *limit, int *key);
+#endif /* #ifdef SCAN_X86 */
+
+static const char *
+findScalar(const ST_SCAN_ENTRY *entry, int count, int mask, const char *stream, const char *limit, int *key);
+
+static int
+verify(const ST_SCAN_ENTRY *entry, int count, const char *stream, const char *limit, int *key);
+
+/********************/
+/* Global variables */
+/********************/
+
+static const ST_SCAN_ENTRY table[SCAN_KEY_COUNT] =
+{
+     { QLP_KEY_KILL, sizeof(QLP_KEY_KILL) - 1, SCAN_KILL }
+    ,{ QLP_KEY_MATCH, sizeof(QLP_KEY_MATCH) - 1, SCAN_MATCH }
+    ,{ QLP_KEY_PLAYER, sizeof(QLP_KEY_PLAYER) - 1, SCAN_PLAYER }
+    ,{ QLP_KEY_SHUTDOWN, sizeof(QLP_KEY_SHUTDOWN) - 1, SCAN_SHUTDOWN }
+};
+
+static PF_SCAN find = findScalar; /* Usable before SCAN_start() */
+
+static const unsigned char lead[256] = /* SCAN_xxx starting with each byte (checked by SCAN_start()) */
+{
+    ['K'] = SCAN_KILL,
+    ['I'] = SCAN_MATCH,
+    ['C'] = SCAN_PLAYER,
+    ['S'] = SCAN_SHUTDOWN
+};
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref scan.h
+ *
+ * @param[in] stream autodescriptive
+ * @param[in] size size of stream
+ * @param[in] mask keys to look for (SCAN_xxx, combined)
+ * @param[out] key key found (SCAN_xxx)
+ *
+ * @return const char * first occurrence or NULL
+ */
+extern const char *
+SCAN_next(const char *stream, unsigned long size, int mask, int *key)
+{
+    ST_SCAN_ENTRY entry[SCAN_KEY_COUNT];
+    int count;
+    int i;
+
+    if (!stream || !key)
+    {
+        return NULL;
+    }
+
+    count = 0;
+
+    for (i = 0; i < SCAN_KEY_COUNT; i++)
+    {
+        if (mask & table[i].key)
+        {
+            entry[count++] = table[i];
+        }
+    }
+
+    if (!count)
+    {
+        return NULL;
+    }
+
+    return find(entry, count, mask, stream, stream + size, key);
+}
+
+/**
+ * @brief @ref scan.h
+ *
+ * @param[in] implementation SCAN_xxx
+ * @param[out] previous implementation in use until now (optional)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SCAN_use(int implementation, int *previous)
+{
+    PF_SCAN function;
+
+    function = NULL;
+
+    if (implementation == SCAN_SCALAR)
+    {
+        function = findScalar;
+    }
+
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+
+    if (implementation == SCAN_SSE2 && __builtin_cpu_supports("sse2"))
+    {
+        function = findSSE2;
+    }
+
+    if (implementation == SCAN_AVX2 && __builtin_cpu_supports("avx2"))
+    {
+        function = findAVX2;
+    }
+
+    if (previous)
+    {
+        *previous = (find == findAVX2) ? SCAN_AVX2 : (find == findSSE2) ? SCAN_SSE2 : SCAN_SCALAR;
+    }
+#else
+    if (previous)
+    {
+        *previous = SCAN_SCALAR;
+    }
+#endif /* #ifdef SCAN_X86 */
+
+    if (!function)
+    {
+        return ERR_FORMAT_NOT_SUPPORTED;
+    }
+
+    find = function;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref scan.h
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SCAN_start(void)
+{
+    static int start = -1;
+    int i;
+
+    if (!start)
+    {
+        return ERR_ALREADY_STARTED;
+    }
+
+    for (i = 0; i < SCAN_KEY_COUNT; i++)
+    {
+        if (!(lead[(unsigned char) table[i].name[0]] & table[i].key))
+        {
+            return ERR_DEFAULT; /* A key was changed, but not lead */
+        }
+    }
+
+    if (SCAN_use(SCAN_AVX2, NULL))
+    {
+        SCAN_use(SCAN_SSE2, NULL);
+    }
+
+    LIBQLP_TRACE("find [%s]", (find == findScalar) ? "scalar" : "SIMD");
+
+    return ERR_NONE;
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+#ifdef SCAN_X86
+/**
+ * @brief Same as findScalar(), 32 positions at a time. A position is only
+ * verified if it holds both the first and the last byte of a key at the
+ * right distance, which rules out nearly every other position of a log.
+ *
+ * @param entry keys to look for
+ * @param count number of keys
+ * @param mask keys to look for (SCAN_xxx, combined)
+ * @param stream autodescriptive
+ * @param limit end of stream
+ * @param key key found (SCAN_xxx)
+ *
+ * @return const char * first occurrence or NULL
+ */
+__attribute__ ((target("avx2")))
+static const char *
+findAVX2(const ST_SCAN_ENTRY *entry, int count, int mask, const char *stream, const char *limit, int *key)
+{
+    __m256i block;
+    __m256i first[SCAN_KEY_COUNT];
+    __m256i last[SCAN_KEY_COUNT];
+    __m256i match;
+    const char *pointer;
+    int i;
+    unsigned int bits;
+    unsigned long reach;
+
+    reach = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        first[i] = _mm256_set1_epi8(entry[i].name[0]);
+
+        last[i] = _mm256_set1_epi8(entry[i].name[entry[i].lenght - 1]);
+
+        reach = (entry[i].lenght > reach) ? entry[i].lenght : reach;
+    }
+
+    while ((unsigned long) (limit - stream) >= reach + sizeof(__m256i) - 1) /* Every load stays in bounds */
+    {
+        block = _mm256_loadu_si256((const __m256i *) stream);
+
+        match = _mm256_setzero_si256();
+
+        for (i = 0; i < count; i++)
+        {
+            match = _mm256_or_si256(match, _mm256_and_si256(_mm256_cmpeq_epi8(block, first[i]),
+                _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (stream + entry[i].lenght - 1)), last[i])));
+        }
+
+        bits = (unsigned int) _mm256_movemask_epi8(match);
+
+        while (bits)
+        {
+            pointer = stream + __builtin_ctz(bits);
+
+            if (verify(entry, count, pointer, limit, key))
+            {
+                return pointer;
+            }
+
+            bits &= bits - 1;
+        }
+
+        stream += sizeof(__m256i);
+    }
+
+    return findScalar(entry, count, mask, stream, limit, key);
+}
+
+/**
+ * @brief Same as findAVX2(), 16 positions at a time.
+ *
+ * @param entry keys to look for
+ * @param count number of keys
+ * @param mask keys to look for (SCAN_xxx, combined)
+ * @param stream autodescriptive
+ * @param limit end of stream
+ * @param key key found (SCAN_xxx)
+ *
+ * @return const char * first occurrence or NULL
+ */
+__attribute__ ((target("sse2")))
+static const char *
+findSSE2(const ST_SCAN_ENTRY *entry, int count, int mask, const char *stream, const char *limit, int *key)
+{
+    __m128i block;
+    __m128i first[SCAN_KEY_COUNT];
+    __m128i last[SCAN_KEY_COUNT];
+    __m128i match;
+    const char *pointer;
+    int i;
+    unsigned int bits;
+    unsigned long reach;
+
+    reach = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        first[i] = _mm_set1_epi8(entry[i].name[0]);
+
+        last[i] = _mm_set1_epi8(entry[i].name[entry[i].lenght - 1]);
+
+        reach = (entry[i].lenght > reach) ? entry[i].lenght : reach;
+    }
+
+    while ((unsigned long) (limit - stream) >= reach + sizeof(__m128i) - 1) /* Every load stays in bounds */
+    {
+        block = _mm_loadu_si128((const __m128i *) stream);
+
+        match = _mm_setzero_si128();
+
+        for (i = 0; i < count; i++)
+        {
+            match = _mm_or_si128(match, _mm_and_si128(_mm_cmpeq_epi8(block, first[i]),
+                _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (stream + entry[i].lenght - 1)), last[i])));
+        }
+
+        bits = (unsigned int) _mm_movemask_epi8(match);
+
+        while (bits)
+        {
+            pointer = stream + __builtin_ctz(bits);
+
+            if (verify(entry, count, pointer, limit, key))
+            {
+                return pointer;
+            }
+
+            bits &= bits - 1;
+        }
+
+        stream += sizeof(__m128i);
+    }
+
+    return findScalar(entry, count, mask, stream, limit, key);
+}
+#endif /* #ifdef SCAN_X86 */
+
+/**
+ * @brief Finds the first position of a stream holding any of the given keys.
+ * Also handles the tail left by the vectorized versions.
+ *
+ * @param entry keys to look for
+ * @param count number of keys
+ * @param mask keys to look for (SCAN_xxx, combined)
+ * @param stream autodescriptive
+ * @param limit end of stream
+ * @param key key found (SCAN_xxx)
+ *
+ * @return const char * first occurrence or NULL
+ */
+static const char *
+findScalar(const ST_SCAN_ENTRY *entry, int count, int mask, const char *stream, const char *limit, int *key)
+{
+    for (; stream < limit; stream++)
+    {
+        if ((lead[(unsigned char) *stream] & mask) && verify(entry, count, stream, limit, key))
+        {
+            return stream;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Checks whether any of the given keys starts at a position.
+ *
+ * @param entry keys to look for
+ * @param count number of keys
+ * @param stream position
+ * @param limit end of stream
+ * @param key key found (SCAN_xxx)
+ *
+ * @return int 1 if found, 0 otherwise
+ */
+static int
+verify(const ST_SCAN_ENTRY *entry, int count, const char *stream, const char *limit, int *key)
+{
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (*stream != entry[i].name[0] || (unsigned long) (limit - stream) < entry[i].lenght)
+        {
+            continue;
+        }
+
+        if (!memcmp(stream, entry[i].name, entry[i].lenght))
+        {
+            *key = entry[i].key;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file scan.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _SCAN_H_INCLUDED_
+#define _SCAN_H_INCLUDED_
+
+#include "qlp.h"
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef enum SCAN_KEY
+{
+    SCAN_KILL = 0x01, /* QLP_KEY_KILL */
+    SCAN_MATCH = 0x02, /* QLP_KEY_MATCH */
+    SCAN_PLAYER = 0x04, /* QLP_KEY_PLAYER */
+    SCAN_SHUTDOWN = 0x08 /* QLP_KEY_SHUTDOWN */
+} EN_SCAN_KEY;
+
+typedef enum SCAN_IMPLEMENTATION
+{
+    SCAN_SCALAR = 0,
+    SCAN_SSE2,
+    SCAN_AVX2
+} EN_SCAN_IMPLEMENTATION;
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Finds the first occurrence of any of the selected keys in a single
+ * pass over a buffer (not necessarily NUL-terminated).
+ *
+ * @param[in] stream autodescriptive
+ * @param[in] size size of stream
+ * @param[in] mask keys to look for (SCAN_xxx, combined)
+ * @param[out] key key found (SCAN_xxx)
+ *
+ * @return const char * first occurrence or NULL
+ */
+extern const char *
+SCAN_next(const char *stream, unsigned long size, int mask, int *key);
+
+/**
+ * @brief Picks the implementation SCAN_next() runs with. SCAN_start() picks
+ * the widest one supported; the others are only picked by tests, comparing
+ * their results. Not thread-safe.
+ *
+ * @param[in] implementation SCAN_xxx
+ * @param[out] previous implementation in use until now (optional)
+ *
+ * @return int ERR_xxx (ERR_FORMAT_NOT_SUPPORTED if the build or the CPU
+ * lacks it)
+ */
+extern int
+SCAN_use(int implementation, int *previous);
+
+/**
+ * @brief Initializes the SCAN API, picking the widest vector extension
+ * supported by the running CPU. Until then, SCAN_next() runs the scalar
+ * implementation.
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SCAN_start(void);
+
+#endif /* #ifndef _SCAN_H_INCLUDED_ */
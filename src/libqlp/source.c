@@ -0,0 +1,465 @@
+/**
+ * @file source.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief SOURCE API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "source.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#ifdef _ZSTD_
+#include <zstd.h>
+#endif /* #ifdef _ZSTD_ */
+
+/**********/
+/* Macros */
+/**********/
+
+#define MAGIC_SIZE 4
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static int
+fill(ST_SOURCE *data, unsigned long size);
+
+static int
+inflateGZIP(ST_SOURCE *data, char *buffer, unsigned long size, unsigned long *count);
+
+#ifdef _ZSTD_
+static int
+inflateZSTD(ST_SOURCE *data, char *buffer, unsigned long size, unsigned long *count);
+#endif /* #ifdef _ZSTD_ */
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref source.h
+ *
+ * @param[in,out] data source structure
+ */
+extern void
+SOURCE_close(ST_SOURCE *data)
+{
+    LIBQLP_TRACE("data [%lu]", data);
+
+    if (!data)
+    {
+        return;
+    }
+
+    if (data->stream)
+    {
+        switch (data->format)
+        {
+        case FORMAT_GZIP:
+            inflateEnd((z_stream *) data->stream);
+            free(data->stream);
+            break;
+
+#ifdef _ZSTD_
+        case FORMAT_ZSTD:
+            ZSTD_freeDStream((ZSTD_DStream *) data->stream);
+            break;
+#endif /* #ifdef _ZSTD_ */
+
+        default:
+            break;
+        }
+    }
+
+    if (data->fd >= 0)
+    {
+        close(data->fd);
+    }
+
+    data->stream = NULL;
+
+    data->fd = -1;
+}
+
+/**
+ * @brief @ref source.h
+ *
+ * @param[in] file file name
+ * @param[out] data source structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SOURCE_open(const char *file, ST_SOURCE *data)
+{
+    static const unsigned char gzip[] = { 0x1F, 0x8B };
+    static const unsigned char zstd[] = { 0x28, 0xB5, 0x2F, 0xFD };
+    z_stream *stream;
+    int retValue;
+
+    LIBQLP_TRACE("*file [%s], data [%lu]", (file) ? file : "(null)", data);
+
+    if (!file || !data)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    memset(data, 0, sizeof(ST_SOURCE) - sizeof(data->input));
+
+    retValue = UTILITIES_open(file, &data->fd);
+
+    if (retValue)
+    {
+        data->fd = -1;
+
+        return retValue;
+    }
+
+    retValue = fill(data, MAGIC_SIZE); /* Peeked bytes are served by SOURCE_read() */
+
+    if (retValue)
+    {
+        SOURCE_close(data);
+
+        return retValue;
+    }
+
+    if (data->end >= sizeof(gzip) && !memcmp(data->input, gzip, sizeof(gzip)))
+    {
+        stream = (z_stream *) malloc(sizeof(z_stream));
+
+        if (!stream)
+        {
+            SOURCE_close(data);
+
+            return ERR_OUT_OF_MEMORY;
+        }
+
+        memset(stream, 0, sizeof(z_stream));
+
+        if (inflateInit2(stream, 15 + 16) != Z_OK) /* gzip header only */
+        {
+            free(stream);
+
+            SOURCE_close(data);
+
+            return ERR_OUT_OF_MEMORY;
+        }
+
+        data->stream = stream;
+
+        data->format = FORMAT_GZIP;
+    }
+    else if (data->end >= sizeof(zstd) && !memcmp(data->input, zstd, sizeof(zstd)))
+    {
+#ifdef _ZSTD_
+        data->stream = ZSTD_createDStream();
+
+        if (!data->stream)
+        {
+            SOURCE_close(data);
+
+            return ERR_OUT_OF_MEMORY;
+        }
+
+        ZSTD_initDStream((ZSTD_DStream *) data->stream);
+
+        data->format = FORMAT_ZSTD;
+#else
+        SOURCE_close(data);
+
+        return ERR_FORMAT_NOT_SUPPORTED;
+#endif /* #ifdef _ZSTD_ */
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref source.h
+ *
+ * @param[in,out] data source structure
+ * @param[out] buffer autodescriptive
+ * @param[in] size size of buffer
+ * @param[out] count number of bytes read (0 on EOF)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SOURCE_read(ST_SOURCE *data, char *buffer, unsigned long size, unsigned long *count)
+{
+    long int bytes;
+
+    if (!data || !buffer || !size || !count)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    *count = 0;
+
+    switch (data->format)
+    {
+    case FORMAT_GZIP:
+        return inflateGZIP(data, buffer, size, count);
+
+#ifdef _ZSTD_
+    case FORMAT_ZSTD:
+        return inflateZSTD(data, buffer, size, count);
+#endif /* #ifdef _ZSTD_ */
+
+    default:
+        break;
+    }
+
+    if (data->begin < data->end) /* Peeked bytes first */
+    {
+        *count = (data->end - data->begin < size) ? data->end - data->begin : size;
+
+        memcpy(buffer, data->input + data->begin, *count);
+
+        data->begin += *count;
+
+        return ERR_NONE;
+    }
+
+    do
+    {
+        bytes = (long int) read(data->fd, buffer, size);
+    }
+    while (bytes < 0 && errno == EINTR);
+
+    if (bytes < 0)
+    {
+        return ERR_DEFAULT;
+    }
+
+    *count = (unsigned long) bytes;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref source.h
+ *
+ * @param[in,out] data source structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SOURCE_rewind(ST_SOURCE *data)
+{
+    if (!data || data->format != FORMAT_PLAIN)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (lseek(data->fd, 0, SEEK_SET) < 0)
+    {
+        return ERR_DEFAULT;
+    }
+
+    data->begin = data->end = 0;
+
+    return ERR_NONE;
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Reads raw bytes into the input buffer until it holds at least
+ * size pending bytes or EOF is hit.
+ *
+ * @param data source structure
+ * @param size wanted number of pending bytes
+ *
+ * @return int ERR_xxx
+ */
+static int
+fill(ST_SOURCE *data, unsigned long size)
+{
+    long int bytes;
+
+    if (data->begin == data->end)
+    {
+        data->begin = data->end = 0;
+    }
+
+    while (data->end - data->begin < size && data->end < sizeof(data->input))
+    {
+        bytes = (long int) read(data->fd, data->input + data->end, sizeof(data->input) - data->end);
+
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (bytes < 0)
+        {
+            return ERR_DEFAULT;
+        }
+
+        if (!bytes)
+        {
+            break; /* EOF */
+        }
+
+        data->end += (unsigned long) bytes;
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Decompresses gzip content. Concatenated members are supported.
+ * zlib counts output bytes in a uInt, so at most UINT_MAX bytes are
+ * produced per call (callers read until EOF anyway).
+ *
+ * @param data source structure
+ * @param buffer autodescriptive
+ * @param size size of buffer
+ * @param count number of bytes read (0 on EOF)
+ *
+ * @return int ERR_xxx
+ */
+static int
+inflateGZIP(ST_SOURCE *data, char *buffer, unsigned long size, unsigned long *count)
+{
+    z_stream *stream;
+    int retValue;
+
+    stream = (z_stream *) data->stream;
+
+    size = (size > UINT_MAX) ? UINT_MAX : size;
+
+    stream->next_out = (Bytef *) buffer;
+
+    stream->avail_out = (uInt) size;
+
+    while (stream->avail_out == size)
+    {
+        if (data->begin == data->end)
+        {
+            retValue = fill(data, 1);
+
+            if (retValue)
+            {
+                return retValue;
+            }
+
+            if (data->begin == data->end)
+            {
+                if (data->member)
+                {
+                    return ERR_DEFAULT; /* Truncated */
+                }
+
+                break; /* EOF */
+            }
+        }
+
+        stream->next_in = data->input + data->begin;
+
+        stream->avail_in = (uInt) (data->end - data->begin);
+
+        retValue = inflate(stream, Z_NO_FLUSH);
+
+        data->begin = data->end - stream->avail_in;
+
+        data->member = 1;
+
+        if (retValue == Z_STREAM_END)
+        {
+            inflateReset(stream); /* Next member, if any */
+
+            data->member = 0;
+        }
+        else if (retValue != Z_OK && retValue != Z_BUF_ERROR)
+        {
+            return ERR_DEFAULT;
+        }
+    }
+
+    *count = size - stream->avail_out;
+
+    return ERR_NONE;
+}
+
+#ifdef _ZSTD_
+/**
+ * @brief Decompresses zstd content. Concatenated frames are supported.
+ *
+ * @param data source structure
+ * @param buffer autodescriptive
+ * @param size size of buffer
+ * @param count number of bytes read (0 on EOF)
+ *
+ * @return int ERR_xxx
+ */
+static int
+inflateZSTD(ST_SOURCE *data, char *buffer, unsigned long size, unsigned long *count)
+{
+    ZSTD_inBuffer input;
+    ZSTD_outBuffer output;
+    size_t retValue;
+
+    output.dst = buffer;
+
+    output.size = size;
+
+    output.pos = 0;
+
+    while (!output.pos)
+    {
+        if (data->begin == data->end)
+        {
+            if (fill(data, 1))
+            {
+                return ERR_DEFAULT;
+            }
+
+            if (data->begin == data->end)
+            {
+                if (data->member)
+                {
+                    return ERR_DEFAULT; /* Truncated */
+                }
+
+                break; /* EOF */
+            }
+        }
+
+        input.src = data->input + data->begin;
+
+        input.size = data->end - data->begin;
+
+        input.pos = 0;
+
+        retValue = ZSTD_decompressStream((ZSTD_DStream *) data->stream, &output, &input);
+
+        if (ZSTD_isError(retValue))
+        {
+            return ERR_DEFAULT;
+        }
+
+        data->begin += input.pos;
+
+        data->member = (retValue != 0); /* 0: frame completed */
+    }
+
+    *count = output.pos;
+
+    return ERR_NONE;
+}
+#endif /* #ifdef _ZSTD_ */
@@ -0,0 +1,92 @@
+/**
+ * @file source.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _SOURCE_H_INCLUDED_
+#define _SOURCE_H_INCLUDED_
+
+#include "qlp.h"
+
+/**********/
+/* Macros */
+/**********/
+
+#define SOURCE_INPUT_SIZE (16 * 1024) /* Raw (compressed) bytes */
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef enum SOURCE_FORMAT
+{
+    FORMAT_PLAIN = 0,
+    FORMAT_GZIP,
+    FORMAT_ZSTD
+} EN_SOURCE_FORMAT;
+
+typedef struct SOURCE
+{
+    void *stream; /* Decompression state */
+    unsigned long begin; /* First input byte not consumed */
+    unsigned long end; /* Last input byte read + 1 */
+    int fd;
+    int format; /* FORMAT_xxx */
+    int member; /* Compressed member in progress */
+    unsigned char input[SOURCE_INPUT_SIZE];
+} ST_SOURCE;
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Closes a source.
+ *
+ * @param[in,out] data source structure
+ */
+extern void
+SOURCE_close(ST_SOURCE *data);
+
+/**
+ * @brief Opens a file (QLP_FILE_STDIN for the standard input) as a source.
+ * Its format is detected from its magic bytes: gzip and, when built with
+ * _ZSTD_, zstd content is decompressed on the fly by SOURCE_read().
+ *
+ * @param[in] file file name
+ * @param[out] data source structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SOURCE_open(const char *file, ST_SOURCE *data);
+
+/**
+ * @brief Reads (decompressed) bytes from a source.
+ *
+ * @param[in,out] data source structure
+ * @param[out] buffer autodescriptive
+ * @param[in] size size of buffer
+ * @param[out] count number of bytes read (0 on EOF)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SOURCE_read(ST_SOURCE *data, char *buffer, unsigned long size, unsigned long *count);
+
+/**
+ * @brief Rewinds a plain source back to its first byte (e.g. after the file
+ * was truncated).
+ *
+ * @param[in,out] data source structure
+ *
+ * @return int ERR_xxx
+ */
+extern int
+SOURCE_rewind(ST_SOURCE *data);
+
+#endif /* #ifndef _SOURCE_H_INCLUDED_ */
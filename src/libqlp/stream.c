@@ -0,0 +1,531 @@
+/**
+ * @file stream.c
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief STREAM API.
+ * @date 2026-10-17
+ *
+ */
+
+#include "stream.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif /* #ifdef __linux__ */
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef struct STREAM
+{
+    ST_MATCH_REPORT match;
+    ST_JSON *json; /* Report stream */
+    volatile sig_atomic_t *stop; /* Follow mode stop request */
+    unsigned long offset; /* Bytes read from the file */
+    unsigned long size; /* Bytes pending in buffer */
+    int follow;
+    int matchCount;
+    int open; /* A match is being aggregated */
+    int discard; /* Follow mode: the open match is dropped when closed */
+    volatile sig_atomic_t halt; /* Stop request, if not following */
+    ST_SOURCE source;
+    char buffer[QLP_STREAM_BUFFER_SIZE];
+} ST_STREAM;
+
+/***********************/
+/* Function prototypes */
+/***********************/
+
+static int
+await(ST_STREAM *data, int notify);
+
+static int
+closeMatch(ST_STREAM *data);
+
+static int
+consume(ST_STREAM *data, int eof);
+
+static int
+evaluate(const char *file, ST_JSON *json, volatile sig_atomic_t *stop);
+
+static int
+line(ST_STREAM *data, const char *stream, unsigned long size);
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief @ref stream.h
+ *
+ * @param[in] file file name
+ * @param[in,out] json report stream (JSON_init()'ed)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+STREAM_evaluate(const char *file, ST_JSON *json)
+{
+    int retValue;
+
+    LIBQLP_TRACE("*file [%s], json [%lu]", (file) ? file : "(null)", json);
+
+    retValue = evaluate(file, json, NULL);
+
+    LIBQLP_TRACE("retValue [%d]", retValue);
+
+    return retValue;
+}
+
+/**
+ * @brief @ref stream.h
+ *
+ * @param[in] file file name
+ * @param[in,out] json report stream (JSON_init()'ed)
+ * @param[in,out] stop stop request (cleared on return)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+STREAM_follow(const char *file, ST_JSON *json, volatile sig_atomic_t *stop)
+{
+    int retValue;
+
+    LIBQLP_TRACE("*file [%s], json [%lu], stop [%lu]", (file) ? file : "(null)", json, stop);
+
+    retValue = ERR_INVALID_ARGUMENT;
+
+    if (stop)
+    {
+        retValue = evaluate(file, json, stop);
+    }
+
+    LIBQLP_TRACE("retValue [%d]", retValue);
+
+    return retValue;
+}
+
+/**
+ * @brief @ref stream.h
+ *
+ * @return int ERR_xxx
+ */
+extern int
+STREAM_start(void)
+{
+    static int start = -1;
+
+    if (!start)
+    {
+        return ERR_ALREADY_STARTED;
+    }
+
+    return ERR_NONE;
+}
+
+/*********************/
+/* Private functions */
+/*********************/
+
+/**
+ * @brief Waits for the followed file to change, for QLP_FOLLOW_TIMEOUT
+ * milliseconds at most. Through inotify where available, by polling
+ * otherwise. A removed or renamed file stops the follow mode; a truncated
+ * one is read again from its beginning.
+ *
+ * @param data stream structure
+ * @param notify inotify descriptor (-1 if unavailable)
+ *
+ * @return int ERR_xxx
+ */
+static int
+await(ST_STREAM *data, int notify)
+{
+    struct pollfd event;
+    struct stat status;
+#ifdef __linux__
+    struct inotify_event *change;
+    char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    long int count;
+    long int i;
+#endif /* #ifdef __linux__ */
+
+    event.fd = notify;
+
+    event.events = POLLIN;
+
+    if (poll(&event, (notify < 0) ? 0 : 1, QLP_FOLLOW_TIMEOUT) > 0)
+    {
+#ifdef __linux__
+        count = (long int) read(notify, buffer, sizeof(buffer));
+
+        for (i = 0; i < count; i += (long int) (sizeof(struct inotify_event) + change->len))
+        {
+            change = (struct inotify_event *) (buffer + i);
+
+            if (change->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+            {
+                *data->stop = 1;
+            }
+        }
+#endif /* #ifdef __linux__ */
+    }
+
+    if (fstat(data->source.fd, &status))
+    {
+        return ERR_DEFAULT;
+    }
+
+    if (!status.st_nlink)
+    {
+        *data->stop = 1; /* Removed */
+    }
+
+    if ((unsigned long) status.st_size < data->offset) /* Truncated */
+    {
+        if (SOURCE_rewind(&data->source))
+        {
+            return ERR_DEFAULT;
+        }
+
+        data->offset = data->size = 0;
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Reports the match being aggregated. Its memory is kept for the
+ * next match (REPORT_reset()).
+ *
+ * @param data stream structure
+ *
+ * @return int ERR_xxx
+ */
+static int
+closeMatch(ST_STREAM *data)
+{
+    int retValue;
+
+    data->open = 0;
+
+    if (data->follow && (data->discard || !data->match.player))
+    {
+        return ERR_NONE; /* Skipped: a live log keeps being followed */
+    }
+
+    if (!data->match.player) /* No players found */
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    data->matchCount += 1;
+
+    retValue = REPORT_print(&data->match, data->matchCount, data->json);
+
+    if (!retValue)
+    {
+        retValue = JSON_flush(data->json); /* Each match goes out as soon as it ends */
+    }
+
+    if (data->follow)
+    {
+        fflush(stdout);
+    }
+
+    return retValue;
+}
+
+/**
+ * @brief Evaluates every complete line pending in the stream buffer and
+ * moves the remaining bytes to its beginning. A line filling the whole
+ * buffer is rejected, since its report could not match QLP_report()'s.
+ *
+ * @param data stream structure
+ * @param eof no more bytes will be appended
+ *
+ * @return int ERR_xxx (ERR_FORMAT_NOT_SUPPORTED if a line does not fit in
+ * the buffer)
+ */
+static int
+consume(ST_STREAM *data, int eof)
+{
+    char *begin;
+    char *end;
+    char *limit;
+    int retValue;
+
+    begin = data->buffer;
+
+    limit = data->buffer + data->size;
+
+    while ((end = (char *) memchr(begin, '\n', (size_t) (limit - begin))))
+    {
+        retValue = line(data, begin, (unsigned long) (end - begin));
+
+        if (retValue)
+        {
+            return retValue;
+        }
+
+        begin = end + 1;
+    }
+
+    data->size = (unsigned long) (limit - begin);
+
+    if (data->size == sizeof(data->buffer) && !eof)
+    {
+        return ERR_FORMAT_NOT_SUPPORTED; /* Oversized line */
+    }
+
+    if (data->size && eof)
+    {
+        retValue = line(data, begin, data->size);
+
+        if (retValue)
+        {
+            return retValue;
+        }
+
+        data->size = 0;
+    }
+
+    memmove(data->buffer, begin, data->size);
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref STREAM_evaluate() and @ref STREAM_follow()
+ *
+ * @param file file name
+ * @param json report stream
+ * @param stop stop request (NULL: no follow mode)
+ *
+ * @return int ERR_xxx
+ */
+static int
+evaluate(const char *file, ST_JSON *json, volatile sig_atomic_t *stop)
+{
+    struct stat status;
+    ST_STREAM *data;
+    int follow;
+    int notify;
+    int retValue;
+    unsigned long count;
+    unsigned long total;
+
+    if (!file || !json)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    if (!file[0])
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    data = (ST_STREAM *) malloc(sizeof(ST_STREAM));
+
+    if (!data)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    memset(data, 0, offsetof(ST_STREAM, source)); /* Buffers are left as is */
+
+    data->json = json;
+
+    data->stop = (stop) ? stop : &data->halt;
+
+    follow = (stop) ? 1 : 0;
+
+    retValue = SOURCE_open(file, &data->source);
+
+    if (retValue)
+    {
+        free(data);
+
+        return retValue;
+    }
+
+    if (follow && (data->source.format != FORMAT_PLAIN || fstat(data->source.fd, &status) || !S_ISREG(status.st_mode)))
+    {
+        follow = 0; /* Pipes and compressed files end at EOF */
+    }
+
+    data->follow = follow;
+
+    notify = -1;
+
+#ifdef __linux__
+    if (follow)
+    {
+        notify = inotify_init();
+
+        if (notify >= 0 && inotify_add_watch(notify, file, IN_MODIFY | IN_DELETE_SELF | IN_MOVE_SELF) < 0)
+        {
+            close(notify);
+
+            notify = -1; /* Falls back to polling */
+        }
+    }
+#endif /* #ifdef __linux__ */
+
+    retValue = ERR_NONE;
+
+    total = 0;
+
+    while (!retValue)
+    {
+        count = 0;
+
+        if (!*data->stop)
+        {
+            retValue = SOURCE_read(&data->source, data->buffer + data->size, sizeof(data->buffer) - data->size, &count);
+
+            if (retValue)
+            {
+                break;
+            }
+        }
+
+        if (!count && follow && !*data->stop)
+        {
+            retValue = await(data, notify);
+
+            continue;
+        }
+
+        total += count;
+
+        data->offset += count;
+
+        data->size += count;
+
+        retValue = consume(data, !count);
+
+        if (!count)
+        {
+            break; /* EOF */
+        }
+    }
+
+    *data->stop = 0; /* Consumed (a request made before the call is not lost) */
+
+    SOURCE_close(&data->source);
+
+    if (notify >= 0)
+    {
+        close(notify);
+    }
+
+    if (!retValue && data->open)
+    {
+        retValue = closeMatch(data);
+    }
+
+    REPORT_free(&data->match);
+
+    if (!retValue && !total && !follow)
+    {
+        retValue = ERR_FILE_EMPTY;
+    }
+
+    if (!retValue && !data->matchCount)
+    {
+        retValue = ERR_MATCH_NOT_FOUND;
+    }
+
+    if (data->matchCount)
+    {
+        REPORT_close(data->matchCount, data->json);
+    }
+
+    free(data);
+
+    return retValue;
+}
+
+/**
+ * @brief Evaluates a single log line, through its event. A match is opened by
+ * EVENT_MATCH and closed by EVENT_SHUTDOWN or by the next EVENT_MATCH.
+ *
+ * @param data stream structure
+ * @param stream log line (not NUL-terminated)
+ * @param size size of log line
+ *
+ * @return int ERR_xxx
+ */
+static int
+line(ST_STREAM *data, const char *stream, unsigned long size)
+{
+    ST_EVENT event;
+    int retValue;
+    unsigned long offset;
+
+    offset = 0;
+
+    if (!EVENT_next(stream, size, &offset, &event))
+    {
+        return ERR_NONE;
+    }
+
+    if (event.type == EVENT_MATCH)
+    {
+        if (data->open)
+        {
+            retValue = closeMatch(data);
+
+            if (retValue)
+            {
+                return retValue;
+            }
+        }
+
+        retValue = REPORT_reset(&data->match); /* Zeroed for the first match */
+
+        if (retValue)
+        {
+            return retValue;
+        }
+
+        data->open = 1;
+
+        data->discard = 0;
+
+        return ERR_NONE;
+    }
+
+    if (!data->open)
+    {
+        return ERR_NONE; /* Out of a match */
+    }
+
+    if (event.type == EVENT_SHUTDOWN)
+    {
+        return closeMatch(data);
+    }
+
+    retValue = REPORT_event(&data->match, stream + event.offset, &event);
+
+    if (retValue && data->follow)
+    {
+        data->discard = 1; /* Malformed line: the match is skipped, not the log */
+
+        return ERR_NONE;
+    }
+
+    return retValue;
+}
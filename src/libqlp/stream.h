@@ -0,0 +1,66 @@
+/**
+ * @file stream.h
+ * @author Maurcio Spinardi (mauricio.spinardi@gmail.com)
+ * @platform cygwin64
+ * @brief Namespace, class or interface definitions.
+ * @date 2026-10-17
+ *
+ */
+
+#ifndef _STREAM_H_INCLUDED_
+#define _STREAM_H_INCLUDED_
+
+#include "qlp.h"
+
+#include <signal.h>
+
+/********************/
+/* Type definitions */
+/********************/
+
+struct JSON; /* json.h */
+
+/********************/
+/* Public functions */
+/********************/
+
+/**
+ * @brief Imports, evaluates and reports a log file through a fixed-size
+ * buffer. Each match is reported (flushed) and released as soon as it is
+ * closed.
+ * Only the given report stream is shared, so distinct files can be streamed
+ * at once from distinct threads, each with its own report stream.
+ *
+ * @param[in] file file name
+ * @param[in,out] json report stream (JSON_init()'ed)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+STREAM_evaluate(const char *file, struct JSON *json);
+
+/**
+ * @brief Same as STREAM_evaluate(), but waits for appends at EOF instead of
+ * returning. Returns once *stop is set (async-signal-safe), even before the
+ * call, or the file is removed or renamed; the match still open at that
+ * point is then reported. A match without players or with a malformed line
+ * is skipped instead of ending the follow.
+ *
+ * @param[in] file file name
+ * @param[in,out] json report stream (JSON_init()'ed)
+ * @param[in,out] stop stop request (cleared on return)
+ *
+ * @return int ERR_xxx
+ */
+extern int
+STREAM_follow(const char *file, struct JSON *json, volatile sig_atomic_t *stop);
+
+/**
+ * @brief Initializes the STREAM API.
+ *
+ * @return int ERR_xxx
+ */
+extern int
+STREAM_start(void);
+
+#endif /* #ifndef _STREAM_H_INCLUDED_ */
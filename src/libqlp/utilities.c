@@ -9,10 +9,14 @@
 
 #include "utilities.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <semaphore.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 /********************/
 /* Global variables */
@@ -60,6 +64,39 @@ UTILITIES_log(const char *date, const char *time, const char *file, const int li
     sem_post(&trace_semaphore);
 }
 
+/**
+ * @brief @ref utilities.h
+ * 
+ * @param[in] file file name
+ * @param[out] fd file descriptor
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+UTILITIES_open(const char *file, int *fd)
+{
+    if (!file || !fd)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    *fd = (strcmp(file, QLP_FILE_STDIN)) ? open(file, O_RDONLY) : dup(STDIN_FILENO);
+
+    if (*fd < 0)
+    {
+        switch (errno)
+        {
+        case ENOENT:
+            return ERR_FILE_NOT_FOUND;
+
+        default:
+            return ERR_DEFAULT;
+        }
+    }
+
+    return ERR_NONE;
+}
+
 /**
  * @brief @ref utilities.h
  * 
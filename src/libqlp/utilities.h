@@ -35,6 +35,18 @@
 extern void
 UTILITIES_log(const char *date, const char *time, const char *file, const int line, const char *function, const char *format, ...);
 
+/**
+ * @brief Opens a file for reading. QLP_FILE_STDIN stands for the standard
+ * input, which is duplicated so the descriptor can always be closed.
+ * 
+ * @param[in] file file name
+ * @param[out] fd file descriptor
+ * 
+ * @return int ERR_xxx
+ */
+extern int
+UTILITIES_open(const char *file, int *fd);
+
 /**
  * @brief Initializes the UTILITIES API.
  * 
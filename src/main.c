@@ -7,18 +7,84 @@
  * 
  */
 
+#define _DEFAULT_SOURCE /* glob(), open_memstream(), scandir(), strdup() */
+
 #include "libqlp/qlp.h" /* (Q)uake (L)og (P)arser API */
 
+#include <dirent.h>
+#include <errno.h>
+#include <glob.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#define WINDOW (2 * QLP_MAX_JOBS) /* Reports parsed ahead of the one printed */
+
+/********************/
+/* Type definitions */
+/********************/
+
+typedef struct LIST
+{
+    char **file;
+    int count;
+    int size; /* Allocated entries */
+} ST_LIST;
+
+typedef struct SLOT
+{
+    char *report;
+    size_t size;
+    int error;
+    sem_t ready; /* Posted once report (or error) is set */
+} ST_SLOT;
+
+typedef struct BATCH
+{
+    ST_LIST *list;
+    int compact;
+    int next; /* Next file to be parsed */
+    sem_t lock; /* Guards next */
+    sem_t room; /* Slots free to be parsed ahead */
+    ST_SLOT slot[WINDOW]; /* File i goes to slot[i % WINDOW] */
+} ST_BATCH;
 
 /***********************/
 /* Function prototypes */
 /***********************/
 
+static int
+add(ST_LIST *list, const char *file);
+
+static int
+batch(ST_LIST *list, int compact, int jobs);
+
+static int
+expand(ST_LIST *list, const char *argument);
+
+static void
+interrupt(int signal);
+
+static int
+parse(ST_QLP_CONTEXT *context, const char *file, ST_SLOT *slot);
+
+static int
+sequence(ST_LIST *list);
+
 static void
 terminate(const char *executable, int error);
 
+static void *
+worker(void *argument);
+
 /********************/
 /* Public functions */
 /********************/
@@ -34,24 +100,138 @@ terminate(const char *executable, int error);
  */
 int main(int argc, char *argv[])
 {
+    ST_LIST list;
     ST_QLP data;
+    char *end;
+    const char *file;
+    int compact;
+    int follow;
+    int i;
+    int inputs;
+    int jobs;
     int retValue;
+    int stream;
+    long int value;
+
+    memset(&list, 0, sizeof(ST_LIST));
+
+    compact = follow = inputs = stream = 0;
+
+    jobs = 1;
+
+    retValue = ERR_NONE;
+
+    for (i = 1; i < argc && !retValue; i++)
+    {
+        if (!strcmp(argv[i], "--compact"))
+        {
+            compact = 1;
+        }
+        else if (!strcmp(argv[i], "--follow"))
+        {
+            follow = 1;
+        }
+        else if (!strcmp(argv[i], "--jobs") && i + 1 < argc)
+        {
+            errno = 0;
+
+            value = strtol(argv[++i], &end, 10);
+
+            jobs = (errno || end == argv[i] || *end || value < 1 || value > QLP_MAX_JOBS) ? 0 : (int) value; /* 0 is rejected below */
+        }
+        else if (!strcmp(argv[i], "--stream"))
+        {
+            stream = 1;
+        }
+        else
+        {
+            retValue = expand(&list, argv[i]);
+
+            inputs++;
+        }
+    }
+
+    if (!retValue && !list.count && inputs)
+    {
+        retValue = ERR_FILE_NOT_FOUND; /* Empty directory */
+    }
+
+    if (!retValue && !list.count)
+    {
+        retValue = add(&list, "-"); /* Standard input */
+    }
+
+    if (retValue)
+    {
+        terminate(argv[0], retValue);
+    }
+
+    if (jobs < 1 || jobs > QLP_MAX_JOBS || (follow && list.count > 1))
+    {
+        terminate(argv[0], ERR_INVALID_ARGUMENT);
+    }
+
+    file = list.file[0];
 
     retValue = QLP_start();
 
-    if (retValue || argc <= 1)
+    if (retValue)
     {
         terminate(argv[0], EXIT_FAILURE);
     }
 
-    retValue = QLP_import(argv[1], &data);
+    if (list.count > 1)
+    {
+        retValue = QLP_setCompact(compact);
+
+        if (retValue)
+        {
+            terminate(argv[0], retValue);
+        }
+
+        retValue = (stream) ? sequence(&list) : batch(&list, compact, jobs);
+
+        exit((retValue) ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+
+    retValue = QLP_setJobs(jobs);
 
     if (retValue)
     {
         terminate(argv[0], retValue);
     }
 
-    retValue = QLP_evaluate(&data);
+    retValue = QLP_setCompact(compact);
+
+    if (retValue)
+    {
+        terminate(argv[0], retValue);
+    }
+
+    if (follow)
+    {
+        signal(SIGINT, interrupt);
+
+        signal(SIGTERM, interrupt);
+
+        terminate(argv[0], QLP_follow(file));
+    }
+
+    if (stream)
+    {
+        terminate(argv[0], QLP_stream(file));
+    }
+
+    if (jobs > 1) /* Reading and splitting overlap with the aggregation */
+    {
+        retValue = QLP_parse(file, &data);
+    }
+    else
+    {
+        retValue = QLP_import(file, &data);
+
+        retValue = (retValue) ? retValue : QLP_evaluate(&data);
+    }
 
     if (retValue)
     {
@@ -74,6 +254,327 @@ int main(int argc, char *argv[])
 /* Private functions */
 /*********************/
 
+/**
+ * @brief Appends a file to a list.
+ * 
+ * @param[in,out] list autodescriptive
+ * @param[in] file autodescriptive (copied)
+ * 
+ * @return int ERR_xxx
+ */
+static int
+add(ST_LIST *list, const char *file)
+{
+    char **entries;
+
+    if (list->count == list->size)
+    {
+        list->size = (list->size) ? list->size * 2 : 16;
+
+        entries = (char **) realloc(list->file, list->size * sizeof(char *));
+
+        if (!entries)
+        {
+            return ERR_OUT_OF_MEMORY;
+        }
+
+        list->file = entries;
+    }
+
+    list->file[list->count] = strdup(file);
+
+    if (!list->file[list->count])
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    list->count++;
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief Parses many files at once, jobs files at a time (one context per
+ * thread), and prints their reports in list order, each one labelled by
+ * its file. Reports are kept in memory until printed, no more than WINDOW
+ * files ahead of the one being printed.
+ * 
+ * @param[in] list files
+ * @param[in] compact autodescriptive (QLP_setCompact())
+ * @param[in] jobs number of threads
+ * 
+ * @return int ERR_xxx of the first file failing
+ */
+static int
+batch(ST_LIST *list, int compact, int jobs)
+{
+    ST_BATCH *data;
+    ST_SLOT *slot;
+    pthread_t thread[QLP_MAX_JOBS];
+    int i;
+    int retValue;
+    int threads;
+
+    data = (ST_BATCH *) calloc(1, sizeof(ST_BATCH));
+
+    if (!data)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    data->list = list;
+
+    data->compact = compact;
+
+    sem_init(&data->lock, 0, 1);
+
+    sem_init(&data->room, 0, (jobs * 2 < WINDOW) ? jobs * 2 : WINDOW);
+
+    for (i = 0; i < WINDOW; i++)
+    {
+        sem_init(&data->slot[i].ready, 0, 0);
+    }
+
+    jobs = (jobs < list->count) ? jobs : list->count;
+
+    for (threads = 0; threads < jobs; threads++)
+    {
+        if (pthread_create(&thread[threads], NULL, worker, data))
+        {
+            break;
+        }
+    }
+
+    retValue = (threads) ? ERR_NONE : ERR_DEFAULT;
+
+    for (i = 0; i < list->count && threads; i++)
+    {
+        slot = &data->slot[i % WINDOW];
+
+        while (sem_wait(&slot->ready));
+
+        printf("%s==> %s <==\n", (i) ? "\n" : "", list->file[i]);
+
+        if (slot->error)
+        {
+            printf("    Error: %d\n", slot->error);
+
+            retValue = (retValue) ? retValue : slot->error;
+        }
+        else
+        {
+            fwrite(slot->report, 1, slot->size, stdout);
+
+            printf("\n");
+        }
+
+        free(slot->report);
+
+        slot->report = NULL;
+
+        sem_post(&data->room);
+    }
+
+    fflush(stdout);
+
+    for (i = 0; i < threads; i++)
+    {
+        pthread_join(thread[i], NULL);
+    }
+
+    for (i = 0; i < WINDOW; i++)
+    {
+        sem_destroy(&data->slot[i].ready);
+    }
+
+    sem_destroy(&data->lock);
+
+    sem_destroy(&data->room);
+
+    free(data);
+
+    return retValue;
+}
+
+/**
+ * @brief Expands a command line argument into the files it names: a
+ * directory stands for its regular files, sorted by name (not recursively),
+ * and a pattern not naming a file stands for its matches (glob(), sorted).
+ * Anything else is taken as is.
+ * 
+ * @param[in,out] list autodescriptive
+ * @param[in] argument autodescriptive
+ * 
+ * @return int ERR_xxx
+ */
+static int
+expand(ST_LIST *list, const char *argument)
+{
+    struct dirent **entry;
+    struct stat status;
+    glob_t matches;
+    char *path;
+    int count;
+    int i;
+    int retValue;
+
+    retValue = ERR_NONE;
+
+    if (!stat(argument, &status) && S_ISDIR(status.st_mode))
+    {
+        count = scandir(argument, &entry, NULL, alphasort);
+
+        if (count < 0)
+        {
+            return ERR_FILE_NOT_FOUND;
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            path = (char *) malloc(strlen(argument) + strlen(entry[i]->d_name) + 2);
+
+            if (!path)
+            {
+                retValue = (retValue) ? retValue : ERR_OUT_OF_MEMORY;
+            }
+            else
+            {
+                sprintf(path, "%s%s%s", argument, (argument[strlen(argument) - 1] == '/') ? "" : "/", entry[i]->d_name);
+
+                if (!retValue && !stat(path, &status) && S_ISREG(status.st_mode))
+                {
+                    retValue = add(list, path);
+                }
+
+                free(path);
+            }
+
+            free(entry[i]);
+        }
+
+        free(entry);
+
+        return retValue;
+    }
+
+    if (!strpbrk(argument, "*?[") || !stat(argument, &status) || glob(argument, 0, NULL, &matches))
+    {
+        return add(list, argument); /* Failing at import if missing */
+    }
+
+    for (i = 0; i < (int) matches.gl_pathc && !retValue; i++)
+    {
+        retValue = expand(list, matches.gl_pathv[i]);
+    }
+
+    globfree(&matches);
+
+    return retValue;
+}
+
+/**
+ * @brief Signal handler. Ends the follow mode gracefully, so the report in
+ * progress is completed.
+ * 
+ * @param[in] signal autodescriptive
+ */
+static void
+interrupt(int signal)
+{
+    (void) signal;
+
+    QLP_stop();
+}
+
+/**
+ * @brief Parses a file within a context, keeping its report in memory. The
+ * context runs a single job (other files keep the other threads busy), so
+ * the file is imported, then evaluated, without pipeline threads.
+ * 
+ * @param[in,out] context autodescriptive
+ * @param[in] file autodescriptive
+ * @param[out] slot report (or error)
+ * 
+ * @return int ERR_xxx
+ */
+static int
+parse(ST_QLP_CONTEXT *context, const char *file, ST_SLOT *slot)
+{
+    ST_QLP data;
+    FILE *output;
+    int retValue;
+
+    slot->report = NULL;
+
+    slot->size = 0;
+
+    memset(&data, 0, sizeof(ST_QLP));
+
+    retValue = QLP_import(file, &data);
+
+    retValue = (retValue) ? retValue : QLP_evaluate_r(context, &data);
+
+    if (!retValue)
+    {
+        output = open_memstream(&slot->report, &slot->size);
+
+        retValue = (output) ? QLP_reportFile_r(context, &data, output) : ERR_OUT_OF_MEMORY;
+
+        if (output && fclose(output) && !retValue)
+        {
+            retValue = ERR_WRITE_FAILED;
+        }
+    }
+
+    QLP_free(&data);
+
+    return retValue;
+}
+
+/**
+ * @brief Streams many files, one after another (QLP_stream()), each report
+ * labelled by its file.
+ * 
+ * @param[in] list files
+ * 
+ * @return int ERR_xxx of the first file failing
+ */
+static int
+sequence(ST_LIST *list)
+{
+    int error;
+    int i;
+    int retValue;
+
+    retValue = ERR_NONE;
+
+    for (i = 0; i < list->count; i++)
+    {
+        printf("%s==> %s <==\n", (i) ? "\n" : "", list->file[i]);
+
+        fflush(stdout);
+
+        error = QLP_stream(list->file[i]);
+
+        fflush(stdout);
+
+        if (error)
+        {
+            printf("    Error: %d\n", error);
+
+            retValue = (retValue) ? retValue : error;
+        }
+        else
+        {
+            printf("\n");
+        }
+    }
+
+    fflush(stdout);
+
+    return retValue;
+}
+
 /**
  * @brief Terminates execution.
  * 
@@ -89,7 +590,7 @@ terminate(const char *executable, int error)
     }
     else
     {
-        printf("\nUsage: %s [file]", executable);
+        printf("\nUsage: %s [--follow|--stream] [--compact] [--jobs N] [file|dir|pattern|-]...", executable);
         printf("\n    Error: %d", error);
         printf("\n");
 
@@ -103,3 +604,61 @@ terminate(const char *executable, int error)
         exit(EXIT_FAILURE);
     }
 }
+
+/**
+ * @brief Batch thread: parses the next file of the list, within a context of
+ * its own, until none is left.
+ * 
+ * @param[in,out] argument batch structure
+ * 
+ * @return void * NULL
+ */
+static void *
+worker(void *argument)
+{
+    ST_BATCH *data;
+    ST_QLP_CONTEXT *context;
+    ST_SLOT *slot;
+    int error;
+    int index;
+
+    data = (ST_BATCH *) argument;
+
+    error = QLP_newContext(&context);
+
+    if (!error)
+    {
+        error = QLP_setCompact_r(context, data->compact);
+    }
+
+    while (1)
+    {
+        while (sem_wait(&data->room));
+
+        sem_wait(&data->lock);
+
+        index = data->next++;
+
+        sem_post(&data->lock);
+
+        if (index >= data->list->count)
+        {
+            sem_post(&data->room); /* Lets the other threads out */
+
+            break;
+        }
+
+        slot = &data->slot[index % WINDOW];
+
+        slot->error = (error) ? error : parse(context, data->list->file[index], slot);
+
+        sem_post(&slot->ready);
+    }
+
+    if (!error)
+    {
+        QLP_freeContext(context);
+    }
+
+    return NULL;
+}
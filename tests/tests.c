@@ -7,11 +7,23 @@
  * 
  */
 
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS, MAP_NORESERVE */
+
 #include "libqlp/qlp.h" /* (Q)uake (L)og (P)arser API */
 
+#include "../src/libqlp/arena.h" /* Internal: ARENA_reset() */
+#include "../src/libqlp/scan.h" /* Internal: SCAN_next(), SCAN_use() */
+#include "../src/libqlp/source.h" /* Internal: SOURCE_read() */
+
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <zlib.h>
 
 /********************/
 /* Type definitions */
@@ -23,6 +35,13 @@ typedef struct UNIT_TESTS
     int (*function)(void);
 } ST_UNIT_TESTS;
 
+typedef struct PARSE
+{
+    ST_QLP_CONTEXT *context;
+    const char *file; /* Report */
+    int error;
+} ST_PARSE;
+
 /*********************/
 /* Private functions */
 /*********************/
@@ -517,6 +536,1086 @@ UT0020(void)
     return QLP_report(&data);
 }
 
+/**
+ * @brief @ref QLP_stream() Invalid argument: file (NULL).
+ * 
+ * @return int ERR_xxx
+ */
+static int
+UT0021(void)
+{
+    int error;
+
+    error = QLP_stream(NULL);
+
+    if (error != ERR_INVALID_ARGUMENT)
+    {
+        return error;
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref QLP_stream() File successfully streamed. Report generated.
+ * Multi-match. Big file (~5000 lines).
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0022(void)
+{
+    return QLP_stream(".\\tests\\UT0020.log");
+}
+
+/**
+ * @brief @ref QLP_follow() Invalid argument: file (NULL).
+ * 
+ * @return int ERR_xxx
+ */
+static int
+UT0023(void)
+{
+    int error;
+
+    error = QLP_follow(NULL);
+
+    if (error != ERR_INVALID_ARGUMENT)
+    {
+        return error;
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref QLP_report() gzip file successfully imported and evaluated.
+ * Report generated.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0024(void)
+{
+    ST_QLP data;
+    int error;
+
+    error = QLP_import(".\\tests\\UT0024.log.gz", &data);
+
+    if (error)
+    {
+        return error;
+    }
+
+    error = QLP_evaluate(&data);
+
+    if (error)
+    {
+        return error;
+    }
+
+    return QLP_report(&data);
+}
+
+/**
+ * @brief @ref QLP_setJobs() Invalid argument: jobs (0).
+ * 
+ * @return int ERR_xxx
+ */
+static int
+UT0025(void)
+{
+    int error;
+
+    error = QLP_setJobs(0);
+
+    if (error != ERR_INVALID_ARGUMENT)
+    {
+        return error;
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref QLP_report() File successfully imported and evaluated across
+ * 4 threads. Report generated. Multi-match. Big file (~5000 lines).
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0026(void)
+{
+    ST_QLP data;
+    int error;
+
+    error = QLP_setJobs(4);
+
+    if (error)
+    {
+        return error;
+    }
+
+    error = QLP_import(".\\tests\\UT0020.log", &data);
+
+    if (!error)
+    {
+        error = QLP_evaluate(&data);
+    }
+
+    if (!error)
+    {
+        error = QLP_report(&data);
+    }
+
+    QLP_free(&data);
+
+    if (error)
+    {
+        return error;
+    }
+
+    return QLP_setJobs(1);
+}
+
+/**
+ * @brief @ref QLP_report() File successfully imported and evaluated. Compact
+ * report generated. Multi-match. Big file (~5000 lines).
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0027(void)
+{
+    ST_QLP data;
+    int error;
+
+    error = QLP_setCompact(2);
+
+    if (error != ERR_INVALID_ARGUMENT)
+    {
+        return (error) ? error : ERR_DEFAULT;
+    }
+
+    error = QLP_setCompact(1);
+
+    if (error)
+    {
+        return error;
+    }
+
+    error = QLP_import(".\\tests\\UT0020.log", &data);
+
+    if (!error)
+    {
+        error = QLP_evaluate(&data);
+    }
+
+    if (!error)
+    {
+        error = QLP_report(&data);
+    }
+
+    QLP_free(&data);
+
+    if (error)
+    {
+        return error;
+    }
+
+    return QLP_setCompact(0);
+}
+
+/**
+ * @brief @ref QLP_reportFd(), QLP_reportFile() and QLP_reportPath() File
+ * successfully imported and evaluated. Same report written to a descriptor,
+ * a stream and a path. Multi-match. Big file (~5000 lines).
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0028(void)
+{
+    static const char *name[3] = { "UT0028.fd", "UT0028.file", "UT0028.json" };
+    static char buffer[3][64 * 1024];
+    ST_QLP data;
+    FILE *file;
+    size_t size[3];
+    int error;
+    int fd;
+    int i;
+
+    error = QLP_import(".\\tests\\UT0020.log", &data);
+
+    if (!error)
+    {
+        error = QLP_evaluate(&data);
+    }
+
+    if (!error)
+    {
+        fd = open(name[0], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        error = (fd < 0) ? ERR_DEFAULT : QLP_reportFd(&data, fd);
+
+        close(fd);
+    }
+
+    if (!error)
+    {
+        file = fopen(name[1], "wb");
+
+        error = (!file) ? ERR_DEFAULT : QLP_reportFile(&data, file);
+
+        fclose(file);
+    }
+
+    if (!error)
+    {
+        error = QLP_reportPath(&data, name[2]);
+    }
+
+    QLP_free(&data);
+
+    for (i = 0; i < 3; i++)
+    {
+        size[i] = 0;
+
+        file = fopen(name[i], "rb");
+
+        if (file)
+        {
+            size[i] = fread(buffer[i], 1, sizeof(buffer[i]), file);
+
+            fclose(file);
+        }
+
+        remove(name[i]);
+    }
+
+    if (error)
+    {
+        return error;
+    }
+
+    if (!size[0] || buffer[0][0] != '{' || buffer[0][size[0] - 1] != '}')
+    {
+        return ERR_DEFAULT;
+    }
+
+    for (i = 1; i < 3; i++)
+    {
+        if (size[i] != size[0] || memcmp(buffer[i], buffer[0], size[0]))
+        {
+            return ERR_DEFAULT;
+        }
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief UT0029() thread: imports, evaluates and reports UT0020.log within
+ * its own context.
+ *
+ * @param argument ST_PARSE structure
+ *
+ * @return void * NULL
+ */
+static void *
+parse(void *argument)
+{
+    ST_PARSE *parse;
+    ST_QLP data;
+
+    parse = (ST_PARSE *) argument;
+
+    parse->error = QLP_import(".\\tests\\UT0020.log", &data);
+
+    if (!parse->error)
+    {
+        parse->error = QLP_evaluate_r(parse->context, &data);
+    }
+
+    if (!parse->error)
+    {
+        parse->error = QLP_reportPath_r(parse->context, &data, parse->file);
+    }
+
+    QLP_free(&data);
+
+    return NULL;
+}
+
+/**
+ * @brief @ref QLP_newContext() Two contexts (one with 3 threads, one
+ * compact) run at once from two threads. Reports match those of the
+ * default context. Multi-match. Big file (~5000 lines).
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0029(void)
+{
+    static const char *name[4] = { "UT0029.0", "UT0029.1", "UT0029.2", "UT0029.3" };
+    static char buffer[4][64 * 1024];
+    ST_PARSE job[2];
+    ST_QLP data;
+    FILE *file;
+    pthread_t thread[2];
+    size_t size[4];
+    int error;
+    int i;
+
+    error = QLP_newContext(&job[0].context);
+
+    if (error)
+    {
+        return error;
+    }
+
+    error = QLP_newContext(&job[1].context);
+
+    if (error)
+    {
+        QLP_freeContext(job[0].context);
+
+        return error;
+    }
+
+    job[0].file = name[0];
+
+    job[1].file = name[1];
+
+    error = QLP_setJobs_r(job[0].context, 3);
+
+    if (!error)
+    {
+        error = QLP_setCompact_r(job[1].context, 1);
+    }
+
+    for (i = 0; i < 2 && !error; i++)
+    {
+        if (pthread_create(&thread[i], NULL, parse, &job[i]))
+        {
+            error = ERR_DEFAULT;
+
+            break;
+        }
+    }
+
+    while (i-- > 0)
+    {
+        pthread_join(thread[i], NULL);
+
+        error = (error) ? error : job[i].error;
+    }
+
+    QLP_freeContext(job[0].context);
+
+    QLP_freeContext(job[1].context);
+
+    if (!error)
+    {
+        error = QLP_import(".\\tests\\UT0020.log", &data);
+    }
+
+    if (!error)
+    {
+        error = QLP_evaluate(&data);
+    }
+
+    if (!error)
+    {
+        error = QLP_reportPath(&data, name[2]);
+    }
+
+    if (!error)
+    {
+        error = QLP_setCompact(1);
+    }
+
+    if (!error)
+    {
+        error = QLP_reportPath(&data, name[3]);
+
+        QLP_setCompact(0);
+    }
+
+    QLP_free(&data);
+
+    for (i = 0; i < 4; i++)
+    {
+        size[i] = 0;
+
+        file = fopen(name[i], "rb");
+
+        if (file)
+        {
+            size[i] = fread(buffer[i], 1, sizeof(buffer[i]), file);
+
+            fclose(file);
+        }
+
+        remove(name[i]);
+    }
+
+    if (error)
+    {
+        return error;
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        if (!size[i] || size[i] != size[i + 2] || memcmp(buffer[i], buffer[i + 2], size[i]))
+        {
+            return ERR_DEFAULT;
+        }
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref QLP_parse() Files successfully imported and evaluated at once
+ * (pipeline), across 3 threads: a mapped one and a compressed one. Reports
+ * match those of QLP_import() and QLP_evaluate(). Multi-match.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0030(void)
+{
+    static const char *file[2] = { ".\\tests\\UT0020.log", ".\\tests\\UT0024.log.gz" };
+    static const char *name[2] = { "UT0030.0", "UT0030.1" };
+    static char buffer[2][64 * 1024];
+    ST_QLP data;
+    FILE *stream;
+    size_t size[2];
+    int error;
+    int i;
+    int j;
+
+    error = QLP_setJobs(3);
+
+    for (i = 0; i < 2 && !error; i++)
+    {
+        error = QLP_import(file[i], &data);
+
+        if (!error)
+        {
+            error = QLP_evaluate(&data);
+        }
+
+        if (!error)
+        {
+            error = QLP_reportPath(&data, name[0]);
+        }
+
+        QLP_free(&data);
+
+        if (!error)
+        {
+            error = QLP_parse(file[i], &data);
+        }
+
+        if (!error)
+        {
+            error = QLP_reportPath(&data, name[1]);
+        }
+
+        QLP_free(&data);
+
+        for (j = 0; j < 2; j++)
+        {
+            size[j] = 0;
+
+            stream = fopen(name[j], "rb");
+
+            if (stream)
+            {
+                size[j] = fread(buffer[j], 1, sizeof(buffer[j]), stream);
+
+                fclose(stream);
+            }
+
+            remove(name[j]);
+        }
+
+        if (!error && (!size[0] || size[1] != size[0] || memcmp(buffer[1], buffer[0], size[0])))
+        {
+            error = ERR_DEFAULT;
+        }
+    }
+
+    if (error)
+    {
+        QLP_setJobs(1);
+
+        return error;
+    }
+
+    return QLP_setJobs(1);
+}
+
+/**
+ * @brief @ref SOURCE_read() A single read of more than UINT_MAX bytes from a
+ * compressed file. Bytes are actually decompressed and counted (zlib takes
+ * at most UINT_MAX bytes per call).
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0031(void)
+{
+    ST_SOURCE source;
+    char *buffer;
+    int error;
+    unsigned long count;
+    unsigned long i;
+    unsigned long size;
+
+    if (sizeof(unsigned long) <= sizeof(unsigned int))
+    {
+        return ERR_NONE; /* No such read */
+    }
+
+    size = (unsigned long) UINT_MAX + 1;
+
+    buffer = (char *) mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (buffer == MAP_FAILED)
+    {
+        return ERR_OUT_OF_MEMORY;
+    }
+
+    error = SOURCE_open(".\\tests\\UT0024.log.gz", &source);
+
+    if (!error)
+    {
+        count = 0;
+
+        error = SOURCE_read(&source, buffer, size, &count);
+
+        if (!error && (!count || count > UINT_MAX))
+        {
+            error = ERR_DEFAULT;
+        }
+
+        for (i = 0; !error && i < count; i++)
+        {
+            if (!buffer[i])
+            {
+                error = ERR_DEFAULT; /* Counted, not written */
+            }
+        }
+
+        SOURCE_close(&source);
+    }
+
+    munmap(buffer, size);
+
+    return error;
+}
+
+/**
+ * @brief Imports, evaluates and reports a log into a file (QLP_reportPath()),
+ * then compares it, byte by byte, with the expected report.
+ *
+ * @param log log file
+ * @param expected expected report file
+ *
+ * @return int ERR_xxx (ERR_DEFAULT if the reports differ)
+ */
+static int
+compare(const char *log, const char *expected)
+{
+    static const char *name = "report.json";
+    static char buffer[2][64 * 1024];
+    ST_QLP data;
+    FILE *file;
+    size_t size[2];
+    int error;
+    int i;
+
+    error = QLP_import(log, &data);
+
+    if (!error)
+    {
+        error = QLP_evaluate(&data);
+    }
+
+    if (!error)
+    {
+        error = QLP_reportPath(&data, name);
+    }
+
+    QLP_free(&data);
+
+    for (i = 0; i < 2; i++)
+    {
+        size[i] = 0;
+
+        file = fopen((i) ? expected : name, "rb");
+
+        if (file)
+        {
+            size[i] = fread(buffer[i], 1, sizeof(buffer[i]), file);
+
+            fclose(file);
+        }
+    }
+
+    remove(name);
+
+    if (error)
+    {
+        return error;
+    }
+
+    if (!size[0] || size[1] != size[0] || memcmp(buffer[1], buffer[0], size[0]))
+    {
+        return ERR_DEFAULT;
+    }
+
+    return ERR_NONE;
+}
+
+/**
+ * @brief @ref QLP_report() Players named after one another (one name is a
+ * prefix of the other): kills are credited to exact names only.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0032(void)
+{
+    return compare(".\\tests\\UT0032.log", ".\\tests\\UT0032.json");
+}
+
+/**
+ * @brief @ref QLP_report() Splash kills (MOD_xxx_SPLASH) are counted under
+ * their own means of death, indexed by MOD ID, apart from direct hits.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0033(void)
+{
+    return compare(".\\tests\\UT0033.log", ".\\tests\\UT0033.json");
+}
+
+/**
+ * @brief @ref QLP_report() Players tracked by client slot: a mid-match
+ * rename (the old name keeps its kills), <world> kills taken from their
+ * victims and a kill on a slot announced only afterwards.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0034(void)
+{
+    return compare(".\\tests\\UT0034.log", ".\\tests\\UT0034.json");
+}
+
+/**
+ * @brief @ref QLP_stream() A line longer than the stream buffer is rejected
+ * (ERR_FORMAT_NOT_SUPPORTED), while QLP_import() and QLP_evaluate() take it.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0035(void)
+{
+    static const char *name = "UT0035.log";
+    ST_QLP data;
+    FILE *file;
+    int error;
+    int i;
+
+    file = fopen(name, "wb");
+
+    if (!file)
+    {
+        return ERR_DEFAULT;
+    }
+
+    fputs("  0:00 InitGame: \\sv_hostname\\Code Miner Server\n", file);
+
+    fputs("  0:05 ClientUserinfoChanged: 2 n\\Isgalamido\\t\\0\n", file);
+
+    fputs("  0:06 say: ", file);
+
+    for (i = 0; i < 80 * 1024; i++)
+    {
+        fputc('x', file);
+    }
+
+    fputs("\n  0:10 ShutdownGame:\n", file);
+
+    fclose(file);
+
+    error = QLP_import(name, &data);
+
+    if (!error)
+    {
+        error = QLP_evaluate(&data);
+    }
+
+    QLP_free(&data);
+
+    if (!error)
+    {
+        error = (QLP_stream(name) == ERR_FORMAT_NOT_SUPPORTED) ? ERR_NONE : ERR_DEFAULT;
+    }
+
+    remove(name);
+
+    return error;
+}
+
+/**
+ * @brief UT0036() thread: stops a follow running within a context, once it
+ * had time to reach EOF.
+ *
+ * @param argument ST_QLP_CONTEXT structure
+ *
+ * @return void * NULL
+ */
+static void *
+stopper(void *argument)
+{
+    usleep(300 * 1000);
+
+    QLP_stop_r((ST_QLP_CONTEXT *) argument);
+
+    return NULL;
+}
+
+/**
+ * @brief @ref QLP_follow_r() A stop requested before the call is honored
+ * (nothing is followed), and a live log keeps being followed past a match
+ * with a malformed kill line and a match without players: both are skipped.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0036(void)
+{
+    static const char *name = "UT0036.log";
+    ST_QLP_CONTEXT *context;
+    pthread_t thread;
+    FILE *file;
+    int error;
+
+    file = fopen(name, "wb");
+
+    if (!file)
+    {
+        return ERR_DEFAULT;
+    }
+
+    fputs("  0:00 InitGame: \\sv_hostname\\Code Miner Server\n", file);
+    fputs("  0:01 ClientUserinfoChanged: 2 n\\Zeh\\t\\0\n", file);
+    fputs("  0:02 Kill: 2 x: Zeh killed\n", file); /* Malformed */
+    fputs("  0:03 ShutdownGame:\n", file);
+    fputs("  0:04 InitGame: \\sv_hostname\\Code Miner Server\n", file);
+    fputs("  0:05 ShutdownGame:\n", file); /* No players */
+    fputs("  0:06 InitGame: \\sv_hostname\\Code Miner Server\n", file);
+    fputs("  0:07 ClientUserinfoChanged: 2 n\\Zeh\\t\\0\n", file);
+    fputs("  0:08 ShutdownGame:\n", file);
+
+    fclose(file);
+
+    error = QLP_newContext(&context);
+
+    if (!error)
+    {
+        QLP_stop_r(context);
+
+        error = (QLP_follow_r(context, name) == ERR_MATCH_NOT_FOUND) ? ERR_NONE : ERR_DEFAULT;
+
+        if (!error && pthread_create(&thread, NULL, stopper, context))
+        {
+            error = ERR_DEFAULT;
+        }
+
+        if (!error)
+        {
+            error = QLP_follow_r(context, name);
+
+            pthread_join(thread, NULL);
+        }
+
+        QLP_freeContext(context);
+    }
+
+    remove(name);
+
+    return error;
+}
+
+/**
+ * @brief UT0037() reference: first position holding any selected key, by
+ * plain comparison.
+ *
+ * @param stream autodescriptive
+ * @param size size of stream
+ * @param mask keys to look for (SCAN_xxx, combined)
+ * @param key key found (SCAN_xxx)
+ *
+ * @return const char * first occurrence or NULL
+ */
+static const char *
+search(const char *stream, int size, int mask, int *key)
+{
+    static const char *name[4] = { "Kill:", "InitGame:", "ClientUserinfoChanged:", "ShutdownGame:" };
+    int i;
+    int j;
+    int lenght;
+
+    for (i = 0; i < size; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            lenght = (int) strlen(name[j]);
+
+            if ((mask & (1 << j)) && i + lenght <= size && !memcmp(stream + i, name[j], lenght))
+            {
+                *key = 1 << j;
+
+                return stream + i;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief @ref SCAN_next() Every implementation available (scalar, SSE2,
+ * AVX2) finds the same key at the same position as a plain search: keys
+ * at every offset of buffers of every size up to 100 bytes (straddling
+ * 16/32-byte blocks, in the last partial block, cut by the end of the
+ * buffer), among near misses, with every key or a single one selected.
+ * Buffers are allocated to size, so an over-read shows under ASan.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0037(void)
+{
+    static const char *name[4] = { "Kill:", "InitGame:", "ClientUserinfoChanged:", "ShutdownGame:" };
+    static const char *noise = "K: I Kill ShutdownGame C:";
+    const char *expected;
+    const char *found;
+    char *buffer;
+    int error;
+    int i;
+    int implementation;
+    int j;
+    int k;
+    int key[2];
+    int mask;
+    int offset;
+    int previous;
+    int size;
+
+    if (SCAN_use(SCAN_SCALAR, &previous))
+    {
+        return ERR_DEFAULT;
+    }
+
+    error = ERR_NONE;
+
+    for (size = 1; !error && size <= 100; size++)
+    {
+        buffer = (char *) malloc(size);
+
+        if (!buffer)
+        {
+            error = ERR_OUT_OF_MEMORY;
+
+            break;
+        }
+
+        for (k = 0; !error && k < 4; k++)
+        {
+            for (offset = 0; !error && offset < size; offset++)
+            {
+                for (i = 0; i < size; i++)
+                {
+                    buffer[i] = noise[i % strlen(noise)];
+                }
+
+                j = (int) strlen(name[k]);
+
+                memcpy(buffer + offset, name[k], (offset + j <= size) ? j : size - offset);
+
+                for (mask = 0x0F; !error && mask; mask = (mask == 0x0F) ? 1 << k : 0)
+                {
+                    expected = search(buffer, size, mask, &key[0]);
+
+                    for (implementation = SCAN_SCALAR; !error && implementation <= SCAN_AVX2; implementation++)
+                    {
+                        if (SCAN_use(implementation, NULL))
+                        {
+                            continue; /* Not available here */
+                        }
+
+                        key[1] = 0;
+
+                        found = SCAN_next(buffer, (unsigned long) size, mask, &key[1]);
+
+                        if (found != expected || (found && key[1] != key[0]))
+                        {
+                            error = ERR_DEFAULT;
+                        }
+                    }
+                }
+            }
+        }
+
+        free(buffer);
+    }
+
+    SCAN_use(previous, NULL);
+
+    return error;
+}
+
+/**
+ * @brief @ref QLP_parse() A compressed log larger than the range reserved
+ * for it (2 MiB in unit tests) is still imported and evaluated: once the
+ * range is exhausted, it is read on into the heap. Reports match those of
+ * QLP_import() and QLP_evaluate(). Multi-match.
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0038(void)
+{
+    static const char *file = "UT0038.log.gz";
+    static const char *name[2] = { "UT0038.0", "UT0038.1" };
+    static char buffer[2][64 * 1024];
+    ST_QLP data;
+    FILE *stream;
+    gzFile log;
+    size_t size[2];
+    int error;
+    int i;
+    int j;
+
+    log = gzopen(file, "wb");
+
+    if (!log)
+    {
+        return ERR_DEFAULT;
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        gzputs(log, "  0:00 InitGame: \\sv_hostname\\Code Miner Server\n");
+
+        gzputs(log, "  0:05 ClientUserinfoChanged: 2 n\\Isgalamido\\t\\0\n");
+
+        gzputs(log, "  0:06 ClientUserinfoChanged: 3 n\\Dono da Bola\\t\\0\n");
+
+        for (j = 0; j < 12000; j++)
+        {
+            gzputs(log, (j % 3) ? "  1:00 Kill: 2 3 7: Isgalamido killed Dono da Bola by MOD_ROCKET_SPLASH\n" : "  1:00 Kill: 1022 2 22: <world> killed Isgalamido by MOD_TRIGGER_HURT\n");
+        }
+
+        gzputs(log, "  2:00 ShutdownGame:\n");
+    }
+
+    gzclose(log);
+
+    error = QLP_import(file, &data);
+
+    if (!error)
+    {
+        error = QLP_evaluate(&data);
+    }
+
+    if (!error)
+    {
+        error = QLP_reportPath(&data, name[0]);
+    }
+
+    QLP_free(&data);
+
+    if (!error)
+    {
+        error = QLP_parse(file, &data);
+    }
+
+    if (!error)
+    {
+        error = QLP_reportPath(&data, name[1]);
+    }
+
+    QLP_free(&data);
+
+    for (j = 0; j < 2; j++)
+    {
+        size[j] = 0;
+
+        stream = fopen(name[j], "rb");
+
+        if (stream)
+        {
+            size[j] = fread(buffer[j], 1, sizeof(buffer[j]), stream);
+
+            fclose(stream);
+        }
+
+        remove(name[j]);
+    }
+
+    remove(file);
+
+    if (!error && (!size[0] || size[1] != size[0] || memcmp(buffer[1], buffer[0], size[0])))
+    {
+        error = ERR_DEFAULT;
+    }
+
+    return error;
+}
+
+/**
+ * @brief @ref ARENA_reset() The largest block is kept, even when a smaller
+ * one was chained after it (an oversized request, then a regular block).
+ *
+ * @return int ERR_xxx
+ */
+static int
+UT0039(void)
+{
+    ST_ARENA arena;
+    int error;
+
+    memset(&arena, 0, sizeof(ST_ARENA));
+
+    error = (ARENA_alloc(&arena, 64) && ARENA_alloc(&arena, 4 * 1024 * 1024) && ARENA_alloc(&arena, 64)) ? ERR_NONE : ERR_OUT_OF_MEMORY;
+
+    if (!error && (!arena.block->next || arena.block->size >= 4 * 1024 * 1024))
+    {
+        error = ERR_DEFAULT; /* Most recent block is not the largest */
+    }
+
+    ARENA_reset(&arena);
+
+    if (!error && (arena.block->next || arena.block->size < 4 * 1024 * 1024 || arena.block->used))
+    {
+        error = ERR_DEFAULT;
+    }
+
+    ARENA_free(&arena);
+
+    return error;
+}
+
 /********************/
 /* Public functions */
 /********************/
@@ -557,6 +1656,25 @@ int main(int argc, char *argv[])
         ,{ "UT0018", UT0018 }
         ,{ "UT0019", UT0019 }
         ,{ "UT0020", UT0020 }
+        ,{ "UT0021", UT0021 }
+        ,{ "UT0022", UT0022 }
+        ,{ "UT0023", UT0023 }
+        ,{ "UT0024", UT0024 }
+        ,{ "UT0025", UT0025 }
+        ,{ "UT0026", UT0026 }
+        ,{ "UT0027", UT0027 }
+        ,{ "UT0028", UT0028 }
+        ,{ "UT0029", UT0029 }
+        ,{ "UT0030", UT0030 }
+        ,{ "UT0031", UT0031 }
+        ,{ "UT0032", UT0032 }
+        ,{ "UT0033", UT0033 }
+        ,{ "UT0034", UT0034 }
+        ,{ "UT0035", UT0035 }
+        ,{ "UT0036", UT0036 }
+        ,{ "UT0037", UT0037 }
+        ,{ "UT0038", UT0038 }
+        ,{ "UT0039", UT0039 }
     };
 
     if (argc != 1)